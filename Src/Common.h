@@ -1,80 +1,104 @@
-#pragma once
-#include <string>
-#include <map>
-#include <unordered_map>
-#include <algorithm>
-
-// Type defs for raw characters
-using UChar = unsigned char;
-using Char = char;
-using WChar = wchar_t;
-
-// Typedef for byte
-using Byte = char;
-
-// Type defs for integer types
-using Int8 = char;
-using UInt8 = unsigned char;
-using Int16 = short;
-using UInt16 = unsigned short;
-using Int32 = int;
-using UInt32 = unsigned int;
-using Int64 = long;
-using UInt64 = unsigned long;
-
-// Typedefs for floating point types
-using Float32 = float;
-using Float64 = double;
-
-namespace lse
-{
-  using String = std::string;
-
-  // Maps stl containers to alias's incase we implement own data
-  // structures later
-  namespace containers
-  {
-    template<class TKey, class TValue>
-    using Map = std::map<TKey, TValue>;
-
-    template<class TKey, class TValue>
-    using UnorderedMap = std::unordered_map<TKey, TValue>;
-
-    template<class TValue>
-    using Vector = std::vector<TValue>;
-    
-
-  }
-
-  // Converts enum class to underlying type
-  template<typename E>
-  constexpr auto to_integral(E e) -> typename std::underlying_type<E>::type {
-    return static_cast<typename std::underlying_type<E>::type>(e);
-  }
-
-  // Converts a string to upper case inplace (replacing old string)
-  inline void to_upper_inplace(String& str)
-  {
-    std::transform(str.begin(), str.end(), str.begin(), ::toupper);
-  }
-
-  // Converts a string to upper case creating a copy and returning it
-  inline String to_upper(String str)
-  {
-    std::transform(str.begin(), str.end(), str.begin(), ::toupper);
-    return std::move(str);
-  }
-
-  // Converts a string to lower case inplace (replacing old string)
-  inline void to_lower_inplace(String& str)
-  {
-    std::transform(str.begin(), str.end(), str.begin(), ::tolower);
-  }
-
-  // Converts a string to lower case creating a copy and returning it
-  inline String to_lower(String str)
-  {
-    std::transform(str.begin(), str.end(), str.begin(), ::tolower);
-    return std::move(str);
-  }
+#pragma once
+#include <string>
+#include <vector>
+#include <memory_resource>
+#include <algorithm>
+#include "Containers/FlatHashMap.h"
+#include "Containers/FlatMap.h"
+
+// Type defs for raw characters
+using UChar = unsigned char;
+using Char = char;
+using WChar = wchar_t;
+
+// Typedef for byte
+using Byte = char;
+
+// Type defs for integer types
+using Int8 = char;
+using UInt8 = unsigned char;
+using Int16 = short;
+using UInt16 = unsigned short;
+using Int32 = int;
+using UInt32 = unsigned int;
+using Int64 = long;
+using UInt64 = unsigned long;
+
+// Typedefs for floating point types
+using Float32 = float;
+using Float64 = double;
+
+namespace lse
+{
+  using String = std::string;
+
+  // Maps stl containers to alias's incase we implement own data
+  // structures later
+  namespace containers
+  {
+    // Sorted array, suited to tables built once and read often
+    template<class TKey, class TValue>
+    using Map = FlatMap<TKey, TValue>;
+
+    template<class TKey>
+    using Set = FlatSet<TKey>;
+
+    // Open addressing, entries move when it grows so box anything that
+    // needs a stable address
+    template<class TKey, class TValue>
+    using UnorderedMap = FlatHashMap<TKey, TValue>;
+
+    template<class TValue, class TAllocator = std::allocator<TValue>>
+    using Vector = std::vector<TValue, TAllocator>;
+
+    // The same containers using polymorphic allocators, so the memory
+    // resource they live in is picked at runtime without changing the type
+    namespace pmr
+    {
+      template<class TKey, class TValue>
+      using Map = FlatMap<TKey, TValue, std::less<TKey>, std::pmr::polymorphic_allocator<std::pair<TKey, TValue>>>;
+
+      template<class TKey>
+      using Set = FlatSet<TKey, std::less<TKey>, std::pmr::polymorphic_allocator<TKey>>;
+
+      template<class TKey, class TValue>
+      using UnorderedMap = FlatHashMap<TKey, TValue, std::hash<TKey>, std::equal_to<TKey>,
+        std::pmr::polymorphic_allocator<std::pair<TKey, TValue>>>;
+
+      template<class TValue>
+      using Vector = std::pmr::vector<TValue>;
+    }
+  }
+
+  // Converts enum class to underlying type
+  template<typename E>
+  constexpr auto to_integral(E e) -> typename std::underlying_type<E>::type {
+    return static_cast<typename std::underlying_type<E>::type>(e);
+  }
+
+  // Converts a string to upper case inplace (replacing old string)
+  inline void to_upper_inplace(String& str)
+  {
+    std::transform(str.begin(), str.end(), str.begin(), ::toupper);
+  }
+
+  // Converts a string to upper case creating a copy and returning it
+  inline String to_upper(String str)
+  {
+    std::transform(str.begin(), str.end(), str.begin(), ::toupper);
+    return std::move(str);
+  }
+
+  // Converts a string to lower case inplace (replacing old string)
+  inline void to_lower_inplace(String& str)
+  {
+    std::transform(str.begin(), str.end(), str.begin(), ::tolower);
+  }
+
+  // Converts a string to lower case creating a copy and returning it
+  inline String to_lower(String str)
+  {
+    std::transform(str.begin(), str.end(), str.begin(), ::tolower);
+    return std::move(str);
+  }
 }
\ No newline at end of file
@@ -0,0 +1,744 @@
+/******************************************************************************
+File: FlatHashMap.h
+Created: 10/21/2026 10:05:37 AM
+Copyright (c) 2017 Turn Tactics
+
+Permission is hereby granted, free of charge, to any person obtaining a copy
+of this software and associated documentation files (the "Software"), to deal
+in the Software without restriction, including without limitation the rights
+to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+copies of the Software, and to permit persons to whom the Software is
+furnished to do so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in
+all copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+SOFTWARE.
+
+Purpose: Defines an open addressing hash map that keeps its entries in one flat
+         array, used as the engine's UnorderedMap.
+
+Author: James Womack
+
+********************************************************************************/
+#pragma once
+
+#include <algorithm>
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+#include <functional>
+#include <initializer_list>
+#include <iterator>
+#include <memory>
+#include <stdexcept>
+#include <tuple>
+#include <type_traits>
+#include <utility>
+
+// Only depends on the standard library so Common.h can include it
+
+namespace lse
+{
+  namespace containers
+  {
+    // Hash map using open addressing with Robin Hood probing. Entries live in
+    // one array with a byte per slot holding how far the entry sits from the
+    // slot its hash picked, and a lookup walks forward from that slot until
+    // it passes entries that are closer to home than the key would be, so
+    // even misses stop after a few adjacent slots. Erasing shifts the entries
+    // behind back a slot instead of leaving tombstones.
+    //
+    // Differences from std::unordered_map: entries are pair<Key, Value> and
+    // the key must not be changed through an iterator, inserting may move
+    // every entry so references and iterators do not survive it, and erasing
+    // invalidates iterators to entries after the erased one except the one
+    // returned. The hash must spread keys well, a run of more than a couple
+    // hundred equal hashes can not be stored.
+    //
+    // The allocator serves both the entries and the distance bytes, so a
+    // polymorphic allocator keeps the whole table in its resource.
+    template<class TKey, class TValue, class THash = std::hash<TKey>, class TKeyEqual = std::equal_to<TKey>,
+      class TAllocator = std::allocator<std::pair<TKey, TValue>>>
+    class FlatHashMap
+    {
+    public:
+      using key_type = TKey;
+      using mapped_type = TValue;
+      using value_type = std::pair<TKey, TValue>;
+      using size_type = size_t;
+      using difference_type = std::ptrdiff_t;
+      using hasher = THash;
+      using key_equal = TKeyEqual;
+      using reference = value_type&;
+      using const_reference = const value_type&;
+      using allocator_type = TAllocator;
+
+      template<bool IsConst>
+      class Iterator
+      {
+      public:
+        using iterator_category = std::forward_iterator_tag;
+        using value_type = typename FlatHashMap::value_type;
+        using difference_type = std::ptrdiff_t;
+        using reference = typename std::conditional<IsConst, const value_type&, value_type&>::type;
+        using pointer = typename std::conditional<IsConst, const value_type*, value_type*>::type;
+        using MapType = typename std::conditional<IsConst, const FlatHashMap, FlatHashMap>::type;
+
+        Iterator() : m_map(nullptr), m_index(0) {}
+
+        // Points at the first entry at or after index
+        Iterator(MapType* map, size_t index) : m_map(map), m_index(index)
+        {
+          skip_empty();
+        }
+
+        operator Iterator<true>() const { return Iterator<true>(m_map, m_index); }
+
+        reference operator*() const { return m_map->m_slots[m_index]; }
+        pointer operator->() const { return &m_map->m_slots[m_index]; }
+
+        Iterator& operator++()
+        {
+          ++m_index;
+          skip_empty();
+          return *this;
+        }
+
+        Iterator operator++(int)
+        {
+          Iterator previous = *this;
+          ++*this;
+          return previous;
+        }
+
+        bool operator==(const Iterator& other) const { return m_index == other.m_index; }
+        bool operator!=(const Iterator& other) const { return m_index != other.m_index; }
+
+      private:
+        friend class FlatHashMap;
+
+        void skip_empty()
+        {
+          while (m_index < m_map->m_slotCount && m_map->m_distances[m_index] == 0)
+          {
+            ++m_index;
+          }
+        }
+
+        MapType* m_map;
+        size_t m_index;
+      };
+
+      using iterator = Iterator<false>;
+      using const_iterator = Iterator<true>;
+
+      FlatHashMap() : FlatHashMap(TAllocator())
+      {
+      }
+
+      explicit FlatHashMap(const TAllocator& allocator) :
+        m_distances(nullptr), m_slots(nullptr), m_size(0), m_capacity(0), m_slotCount(0), m_shift(0),
+        m_maxDistance(0), m_allocator(allocator)
+      {
+      }
+
+      explicit FlatHashMap(size_t count, const THash& hash = THash(), const TKeyEqual& equal = TKeyEqual(),
+        const TAllocator& allocator = TAllocator()) :
+        FlatHashMap(allocator)
+      {
+        m_hash = hash;
+        m_equal = equal;
+        reserve(count);
+      }
+
+      template<class TIterator>
+      FlatHashMap(TIterator first, TIterator last, const TAllocator& allocator = TAllocator()) :
+        FlatHashMap(allocator)
+      {
+        insert(first, last);
+      }
+
+      // Like std::unordered_map the first of several equal keys wins
+      FlatHashMap(std::initializer_list<value_type> values, const TAllocator& allocator = TAllocator()) :
+        FlatHashMap(allocator)
+      {
+        reserve(values.size());
+        insert(values.begin(), values.end());
+      }
+
+      FlatHashMap(const FlatHashMap& other) :
+        FlatHashMap(AllocatorTraits::select_on_container_copy_construction(other.m_allocator))
+      {
+        copy_from(other);
+      }
+
+      FlatHashMap(const FlatHashMap& other, const TAllocator& allocator) :
+        FlatHashMap(allocator)
+      {
+        copy_from(other);
+      }
+
+      FlatHashMap(FlatHashMap&& other) noexcept :
+        FlatHashMap(other.m_allocator)
+      {
+        swap_table(other);
+      }
+
+      ~FlatHashMap()
+      {
+        clear();
+        free_table();
+      }
+
+      FlatHashMap& operator=(const FlatHashMap& other)
+      {
+        if (this != &other)
+        {
+          clear();
+          free_table();
+          if constexpr (AllocatorTraits::propagate_on_container_copy_assignment::value)
+          {
+            m_allocator = other.m_allocator;
+          }
+          copy_from(other);
+        }
+
+        return *this;
+      }
+
+      // Entries are moved one by one when the allocators differ and do not
+      // propagate, as the table can not change hands between resources
+      FlatHashMap& operator=(FlatHashMap&& other)
+      {
+        if (this != &other)
+        {
+          clear();
+          free_table();
+          if constexpr (AllocatorTraits::propagate_on_container_move_assignment::value)
+          {
+            m_allocator = std::move(other.m_allocator);
+            swap_table(other);
+          }
+          else if (m_allocator == other.m_allocator)
+          {
+            swap_table(other);
+          }
+          else
+          {
+            move_from(other);
+          }
+        }
+
+        return *this;
+      }
+
+      allocator_type get_allocator() const { return m_allocator; }
+
+      // Iterators
+      iterator begin() { return iterator(this, 0); }
+      iterator end() { return iterator(this, m_slotCount); }
+      const_iterator begin() const { return const_iterator(this, 0); }
+      const_iterator end() const { return const_iterator(this, m_slotCount); }
+      const_iterator cbegin() const { return begin(); }
+      const_iterator cend() const { return end(); }
+
+      // Capacity
+      bool empty() const { return m_size == 0; }
+      size_t size() const { return m_size; }
+      size_t bucket_count() const { return m_capacity; }
+      float load_factor() const { return m_capacity > 0 ? static_cast<float>(m_size) / m_capacity : 0.0f; }
+
+      // Grows so count entries fit without another rehash
+      void reserve(size_t count)
+      {
+        size_t capacity = m_capacity > 0 ? m_capacity : MinCapacity;
+        while (count > max_load(capacity))
+        {
+          capacity *= 2;
+        }
+
+        if (capacity != m_capacity)
+        {
+          rehash(capacity);
+        }
+      }
+
+      // Lookup
+      iterator find(const TKey& key)
+      {
+        return iterator(this, find_index(key));
+      }
+
+      const_iterator find(const TKey& key) const
+      {
+        return const_iterator(this, find_index(key));
+      }
+
+      size_t count(const TKey& key) const { return find_index(key) != m_slotCount ? 1 : 0; }
+      bool contains(const TKey& key) const { return find_index(key) != m_slotCount; }
+
+      TValue& at(const TKey& key)
+      {
+        const size_t index = find_index(key);
+        if (index == m_slotCount)
+        {
+          throw std::out_of_range("FlatHashMap key not found");
+        }
+
+        return m_slots[index].second;
+      }
+
+      const TValue& at(const TKey& key) const
+      {
+        const size_t index = find_index(key);
+        if (index == m_slotCount)
+        {
+          throw std::out_of_range("FlatHashMap key not found");
+        }
+
+        return m_slots[index].second;
+      }
+
+      TValue& operator[](const TKey& key)
+      {
+        return try_emplace(key).first->second;
+      }
+
+      TValue& operator[](TKey&& key)
+      {
+        return try_emplace(std::move(key)).first->second;
+      }
+
+      // Modifiers
+      template<class... TArgs>
+      std::pair<iterator, bool> try_emplace(const TKey& key, TArgs&&... args)
+      {
+        const size_t index = find_index(key);
+        if (index != m_slotCount)
+        {
+          return std::make_pair(iterator(this, index), false);
+        }
+
+        return std::make_pair(iterator(this, insert_new(value_type(std::piecewise_construct,
+          std::forward_as_tuple(key), std::forward_as_tuple(std::forward<TArgs>(args)...)))), true);
+      }
+
+      template<class... TArgs>
+      std::pair<iterator, bool> try_emplace(TKey&& key, TArgs&&... args)
+      {
+        const size_t index = find_index(key);
+        if (index != m_slotCount)
+        {
+          return std::make_pair(iterator(this, index), false);
+        }
+
+        return std::make_pair(iterator(this, insert_new(value_type(std::piecewise_construct,
+          std::forward_as_tuple(std::move(key)), std::forward_as_tuple(std::forward<TArgs>(args)...)))), true);
+      }
+
+      template<class... TArgs>
+      std::pair<iterator, bool> emplace(TArgs&&... args)
+      {
+        return insert(value_type(std::forward<TArgs>(args)...));
+      }
+
+      std::pair<iterator, bool> insert(const value_type& value)
+      {
+        return try_emplace(value.first, value.second);
+      }
+
+      std::pair<iterator, bool> insert(value_type&& value)
+      {
+        const size_t index = find_index(value.first);
+        if (index != m_slotCount)
+        {
+          return std::make_pair(iterator(this, index), false);
+        }
+
+        return std::make_pair(iterator(this, insert_new(std::move(value))), true);
+      }
+
+      template<class TIterator>
+      void insert(TIterator first, TIterator last)
+      {
+        for (; first != last; ++first)
+        {
+          insert(*first);
+        }
+      }
+
+      template<class TMapped>
+      std::pair<iterator, bool> insert_or_assign(const TKey& key, TMapped&& value)
+      {
+        std::pair<iterator, bool> result = try_emplace(key, std::forward<TMapped>(value));
+        if (!result.second)
+        {
+          result.first->second = std::forward<TMapped>(value);
+        }
+
+        return result;
+      }
+
+      size_t erase(const TKey& key)
+      {
+        const size_t index = find_index(key);
+        if (index == m_slotCount)
+        {
+          return 0;
+        }
+
+        erase_index(index);
+        return 1;
+      }
+
+      // Returns the entry after the erased one
+      iterator erase(const_iterator position)
+      {
+        erase_index(position.m_index);
+        return iterator(this, position.m_index);
+      }
+
+      void clear()
+      {
+        for (size_t i = 0; i < m_slotCount; ++i)
+        {
+          if (m_distances[i] != 0)
+          {
+            destroy(m_slots + i);
+            m_distances[i] = 0;
+          }
+        }
+
+        m_size = 0;
+      }
+
+      // Like the standard containers the allocators must be equal unless
+      // they propagate on swap
+      void swap(FlatHashMap& other) noexcept
+      {
+        if constexpr (AllocatorTraits::propagate_on_container_swap::value)
+        {
+          std::swap(m_allocator, other.m_allocator);
+        }
+
+        swap_table(other);
+      }
+
+    private:
+      using AllocatorTraits = std::allocator_traits<TAllocator>;
+      using DistanceAllocator = typename AllocatorTraits::template rebind_alloc<std::uint8_t>;
+      using SlotAllocator = typename AllocatorTraits::template rebind_alloc<value_type>;
+
+      static constexpr size_t MinCapacity = 8;
+
+      // Distances are stored plus one in a byte, zero marks an empty slot
+      static constexpr size_t DistanceLimit = 254;
+
+      // Exchanges everything but the allocators
+      void swap_table(FlatHashMap& other) noexcept
+      {
+        std::swap(m_distances, other.m_distances);
+        std::swap(m_slots, other.m_slots);
+        std::swap(m_size, other.m_size);
+        std::swap(m_capacity, other.m_capacity);
+        std::swap(m_slotCount, other.m_slotCount);
+        std::swap(m_shift, other.m_shift);
+        std::swap(m_maxDistance, other.m_maxDistance);
+        std::swap(m_hash, other.m_hash);
+        std::swap(m_equal, other.m_equal);
+      }
+
+      // Entries are built through the allocator so ones that take an
+      // allocator themselves, like pmr strings, share the map's resource
+      template<class... TArgs>
+      void construct(value_type* slot, TArgs&&... args)
+      {
+        SlotAllocator allocator(m_allocator);
+        std::allocator_traits<SlotAllocator>::construct(allocator, slot, std::forward<TArgs>(args)...);
+      }
+
+      void destroy(value_type* slot)
+      {
+        SlotAllocator allocator(m_allocator);
+        std::allocator_traits<SlotAllocator>::destroy(allocator, slot);
+      }
+
+      // Entries allowed before growing, seven eighths of the capacity
+      static size_t max_load(size_t capacity)
+      {
+        return capacity - capacity / 8;
+      }
+
+      // Picks the home slot from the top bits of a Fibonacci hash so hashes
+      // that only differ in their high or low bits still spread out, which
+      // matters as std::hash of an integer is often the integer itself
+      size_t home(const TKey& key) const
+      {
+        const std::uint64_t hash = static_cast<std::uint64_t>(m_hash(key)) * 0x9E3779B97F4A7C15ull;
+        return static_cast<size_t>(hash >> (64 - m_shift));
+      }
+
+      // Returns the slot holding key, or m_slotCount if it is not there
+      size_t find_index(const TKey& key) const
+      {
+        if (m_size == 0)
+        {
+          return m_slotCount;
+        }
+
+        size_t index = home(key);
+        for (size_t distance = 0; distance <= m_maxDistance; ++distance, ++index)
+        {
+          const size_t stored = m_distances[index];
+
+          // Past an empty slot or an entry closer to home the key would have
+          // displaced, so it is not in the map
+          if (stored == 0 || stored - 1 < distance)
+          {
+            break;
+          }
+
+          if (stored - 1 == distance && m_equal(m_slots[index].first, key))
+          {
+            return index;
+          }
+        }
+
+        return m_slotCount;
+      }
+
+      // Inserts a key known not to be in the map and returns its slot
+      size_t insert_new(value_type&& value)
+      {
+        if (m_size + 1 > max_load(m_capacity))
+        {
+          rehash(m_capacity > 0 ? m_capacity * 2 : MinCapacity);
+        }
+
+        size_t index = place(std::move(value));
+        while (index == m_slotCount)
+        {
+          rehash(m_capacity * 2);
+          index = place(std::move(value));
+        }
+
+        return index;
+      }
+
+      // Puts a new entry where Robin Hood probing wants it, shifting the
+      // entries from there to the next empty slot back by one. Returns
+      // m_slotCount without touching value if that would push an entry past
+      // the longest allowed distance.
+      size_t place(value_type&& value)
+      {
+        if (m_capacity == 0)
+        {
+          return m_slotCount;
+        }
+
+        // Walk to the first empty slot or entry closer to home than us
+        size_t index = home(value.first);
+        size_t distance = 0;
+        while (m_distances[index] != 0 && m_distances[index] - 1u >= distance)
+        {
+          ++index;
+          ++distance;
+          if (distance > m_maxDistance)
+          {
+            return m_slotCount;
+          }
+        }
+
+        // Find the end of the run that has to move and check it can
+        size_t empty = index;
+        while (m_distances[empty] != 0)
+        {
+          if (m_distances[empty] - 1u >= m_maxDistance)
+          {
+            return m_slotCount;
+          }
+
+          ++empty;
+        }
+
+        if (empty == index)
+        {
+          construct(m_slots + index, std::move(value));
+        }
+        else
+        {
+          construct(m_slots + empty, std::move(m_slots[empty - 1]));
+          for (size_t i = empty - 1; i > index; --i)
+          {
+            m_slots[i] = std::move(m_slots[i - 1]);
+          }
+          m_slots[index] = std::move(value);
+
+          for (size_t i = empty; i > index; --i)
+          {
+            m_distances[i] = static_cast<std::uint8_t>(m_distances[i - 1] + 1);
+          }
+        }
+
+        m_distances[index] = static_cast<std::uint8_t>(distance + 1);
+        ++m_size;
+        return index;
+      }
+
+      // Removes the entry in a slot and shifts the entries behind it that
+      // are away from home back by one
+      void erase_index(size_t index)
+      {
+        destroy(m_slots + index);
+
+        size_t next = index + 1;
+        while (next < m_slotCount && m_distances[next] > 1)
+        {
+          construct(m_slots + next - 1, std::move(m_slots[next]));
+          destroy(m_slots + next);
+          m_distances[next - 1] = static_cast<std::uint8_t>(m_distances[next] - 1);
+          ++next;
+        }
+
+        m_distances[next - 1] = 0;
+        --m_size;
+      }
+
+      // Moves every entry into a table with room for capacity entries
+      void rehash(size_t capacity)
+      {
+        FlatHashMap other(m_allocator);
+        other.m_hash = m_hash;
+        other.m_equal = m_equal;
+        other.allocate_table(capacity);
+
+        for (size_t i = 0; i < m_slotCount; ++i)
+        {
+          if (m_distances[i] != 0)
+          {
+            while (other.place(std::move(m_slots[i])) == other.m_slotCount)
+            {
+              other.rehash(other.m_capacity * 2);
+            }
+          }
+        }
+
+        swap_table(other);
+      }
+
+      // Allocates empty storage for capacity entries, capacity must be a power
+      // of two. Slots past the capacity catch entries pushed off the end so
+      // probing never wraps around.
+      void allocate_table(size_t capacity)
+      {
+        m_capacity = capacity;
+        m_shift = 0;
+        while ((static_cast<size_t>(1) << m_shift) < capacity)
+        {
+          ++m_shift;
+        }
+
+        m_maxDistance = std::min(DistanceLimit, 4 * static_cast<size_t>(m_shift));
+        m_slotCount = capacity + m_maxDistance + 1;
+        DistanceAllocator distances(m_allocator);
+        SlotAllocator slots(m_allocator);
+        m_distances = std::allocator_traits<DistanceAllocator>::allocate(distances, m_slotCount);
+        std::memset(m_distances, 0, m_slotCount);
+        m_slots = std::allocator_traits<SlotAllocator>::allocate(slots, m_slotCount);
+      }
+
+      // Frees the storage, the entries must already be destroyed
+      void free_table()
+      {
+        if (m_slots != nullptr)
+        {
+          DistanceAllocator distances(m_allocator);
+          SlotAllocator slots(m_allocator);
+          std::allocator_traits<DistanceAllocator>::deallocate(distances, m_distances, m_slotCount);
+          std::allocator_traits<SlotAllocator>::deallocate(slots, m_slots, m_slotCount);
+        }
+
+        m_distances = nullptr;
+        m_slots = nullptr;
+        m_capacity = 0;
+        m_slotCount = 0;
+        m_shift = 0;
+        m_maxDistance = 0;
+      }
+
+      // Copies other's entries into the same slots, this must be empty with
+      // no table
+      void copy_from(const FlatHashMap& other)
+      {
+        m_hash = other.m_hash;
+        m_equal = other.m_equal;
+        if (other.m_capacity == 0)
+        {
+          return;
+        }
+
+        allocate_table(other.m_capacity);
+        for (size_t i = 0; i < m_slotCount; ++i)
+        {
+          if (other.m_distances[i] != 0)
+          {
+            construct(m_slots + i, other.m_slots[i]);
+            m_distances[i] = other.m_distances[i];
+          }
+        }
+
+        m_size = other.m_size;
+      }
+
+      // Moves other's entries into the same slots and empties it, this must
+      // be empty with no table
+      void move_from(FlatHashMap& other)
+      {
+        m_hash = other.m_hash;
+        m_equal = other.m_equal;
+        if (other.m_capacity == 0)
+        {
+          return;
+        }
+
+        allocate_table(other.m_capacity);
+        for (size_t i = 0; i < m_slotCount; ++i)
+        {
+          if (other.m_distances[i] != 0)
+          {
+            construct(m_slots + i, std::move(other.m_slots[i]));
+            m_distances[i] = other.m_distances[i];
+          }
+        }
+
+        m_size = other.m_size;
+        other.clear();
+      }
+
+      std::uint8_t* m_distances;
+      value_type* m_slots;
+      size_t m_size;
+      size_t m_capacity;
+      size_t m_slotCount;
+      size_t m_shift;
+      size_t m_maxDistance;
+      THash m_hash;
+      TKeyEqual m_equal;
+      TAllocator m_allocator;
+    };
+
+    template<class TKey, class TValue, class THash, class TKeyEqual, class TAllocator>
+    void swap(FlatHashMap<TKey, TValue, THash, TKeyEqual, TAllocator>& left,
+      FlatHashMap<TKey, TValue, THash, TKeyEqual, TAllocator>& right) noexcept
+    {
+      left.swap(right);
+    }
+  }
+}
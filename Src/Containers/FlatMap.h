@@ -0,0 +1,567 @@
+/******************************************************************************
+File: FlatMap.h
+Created: 10/21/2026 2:38:10 PM
+Copyright (c) 2017 Turn Tactics
+
+Permission is hereby granted, free of charge, to any person obtaining a copy
+of this software and associated documentation files (the "Software"), to deal
+in the Software without restriction, including without limitation the rights
+to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+copies of the Software, and to permit persons to whom the Software is
+furnished to do so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in
+all copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+SOFTWARE.
+
+Purpose: Defines ordered map and set containers kept as sorted arrays, used as
+         the engine's Map for tables that are built once and read often.
+
+Author: James Womack
+
+********************************************************************************/
+#pragma once
+
+#include <algorithm>
+#include <functional>
+#include <initializer_list>
+#include <memory>
+#include <stdexcept>
+#include <tuple>
+#include <utility>
+#include <vector>
+
+// Only depends on the standard library so Common.h can include it
+
+namespace lse
+{
+  namespace containers
+  {
+    // Tag for constructors taking values that are already sorted and unique
+    struct SortedUnique {};
+
+    // Ordered map stored as a sorted array of pairs. Lookups are binary
+    // searches over contiguous memory and iteration is a linear walk, which
+    // beats a tree for tables that are filled once and then only read.
+    // Inserting or erasing one entry moves every entry after it, so build
+    // big tables in bulk with the range constructor or insert(first, last),
+    // which sort once.
+    //
+    // Differences from std::map: entries are pair<Key, Value> and the key
+    // must not be changed through an iterator, and inserting or erasing
+    // invalidates iterators and references like a vector does. The
+    // allocator is the entry vector's.
+    template<class TKey, class TValue, class TCompare = std::less<TKey>,
+      class TAllocator = std::allocator<std::pair<TKey, TValue>>>
+    class FlatMap
+    {
+    public:
+      using key_type = TKey;
+      using mapped_type = TValue;
+      using value_type = std::pair<TKey, TValue>;
+      using key_compare = TCompare;
+      using allocator_type = TAllocator;
+      using container_type = std::vector<value_type, TAllocator>;
+      using size_type = size_t;
+      using iterator = typename container_type::iterator;
+      using const_iterator = typename container_type::const_iterator;
+      using reverse_iterator = typename container_type::reverse_iterator;
+      using const_reverse_iterator = typename container_type::const_reverse_iterator;
+
+      FlatMap() = default;
+
+      explicit FlatMap(const TCompare& compare, const TAllocator& allocator = TAllocator()) :
+        m_values(allocator), m_compare(compare)
+      {
+      }
+
+      explicit FlatMap(const TAllocator& allocator) : m_values(allocator) {}
+
+      // Like std::map the first of several equal keys wins
+      template<class TIterator>
+      FlatMap(TIterator first, TIterator last, const TCompare& compare = TCompare(),
+        const TAllocator& allocator = TAllocator()) :
+        m_values(first, last, allocator), m_compare(compare)
+      {
+        sort_unique(0);
+      }
+
+      FlatMap(std::initializer_list<value_type> values, const TCompare& compare = TCompare(),
+        const TAllocator& allocator = TAllocator()) :
+        FlatMap(values.begin(), values.end(), compare, allocator)
+      {
+      }
+
+      FlatMap(const FlatMap& other) = default;
+      FlatMap(FlatMap&& other) = default;
+
+      FlatMap(const FlatMap& other, const TAllocator& allocator) :
+        m_values(other.m_values, allocator), m_compare(other.m_compare)
+      {
+      }
+
+      FlatMap& operator=(const FlatMap& other) = default;
+      FlatMap& operator=(FlatMap&& other) = default;
+
+      // Takes values that are already sorted with no equal keys
+      FlatMap(SortedUnique, container_type values, const TCompare& compare = TCompare()) :
+        m_values(std::move(values)), m_compare(compare)
+      {
+      }
+
+      // Iterators
+      iterator begin() { return m_values.begin(); }
+      iterator end() { return m_values.end(); }
+      const_iterator begin() const { return m_values.begin(); }
+      const_iterator end() const { return m_values.end(); }
+      const_iterator cbegin() const { return m_values.cbegin(); }
+      const_iterator cend() const { return m_values.cend(); }
+      reverse_iterator rbegin() { return m_values.rbegin(); }
+      reverse_iterator rend() { return m_values.rend(); }
+      const_reverse_iterator rbegin() const { return m_values.rbegin(); }
+      const_reverse_iterator rend() const { return m_values.rend(); }
+
+      // Capacity
+      bool empty() const { return m_values.empty(); }
+      size_t size() const { return m_values.size(); }
+      size_t capacity() const { return m_values.capacity(); }
+      void reserve(size_t count) { m_values.reserve(count); }
+      void shrink_to_fit() { m_values.shrink_to_fit(); }
+
+      // The sorted entries
+      const container_type& values() const { return m_values; }
+
+      allocator_type get_allocator() const { return m_values.get_allocator(); }
+
+      // Lookup
+      iterator lower_bound(const TKey& key)
+      {
+        return std::lower_bound(m_values.begin(), m_values.end(), key, KeyLess(m_compare));
+      }
+
+      const_iterator lower_bound(const TKey& key) const
+      {
+        return std::lower_bound(m_values.begin(), m_values.end(), key, KeyLess(m_compare));
+      }
+
+      iterator upper_bound(const TKey& key)
+      {
+        return std::upper_bound(m_values.begin(), m_values.end(), key, KeyLess(m_compare));
+      }
+
+      const_iterator upper_bound(const TKey& key) const
+      {
+        return std::upper_bound(m_values.begin(), m_values.end(), key, KeyLess(m_compare));
+      }
+
+      std::pair<iterator, iterator> equal_range(const TKey& key)
+      {
+        const iterator it = find(key);
+        return std::make_pair(it, it == end() ? it : it + 1);
+      }
+
+      std::pair<const_iterator, const_iterator> equal_range(const TKey& key) const
+      {
+        const const_iterator it = find(key);
+        return std::make_pair(it, it == end() ? it : it + 1);
+      }
+
+      iterator find(const TKey& key)
+      {
+        const iterator it = lower_bound(key);
+        return it != end() && !m_compare(key, it->first) ? it : end();
+      }
+
+      const_iterator find(const TKey& key) const
+      {
+        const const_iterator it = lower_bound(key);
+        return it != end() && !m_compare(key, it->first) ? it : end();
+      }
+
+      size_t count(const TKey& key) const { return find(key) != end() ? 1 : 0; }
+      bool contains(const TKey& key) const { return find(key) != end(); }
+
+      TValue& at(const TKey& key)
+      {
+        const iterator it = find(key);
+        if (it == end())
+        {
+          throw std::out_of_range("FlatMap key not found");
+        }
+
+        return it->second;
+      }
+
+      const TValue& at(const TKey& key) const
+      {
+        const const_iterator it = find(key);
+        if (it == end())
+        {
+          throw std::out_of_range("FlatMap key not found");
+        }
+
+        return it->second;
+      }
+
+      TValue& operator[](const TKey& key)
+      {
+        return try_emplace(key).first->second;
+      }
+
+      TValue& operator[](TKey&& key)
+      {
+        return try_emplace(std::move(key)).first->second;
+      }
+
+      // Modifiers
+      template<class TKeyArg, class... TArgs>
+      std::pair<iterator, bool> try_emplace(TKeyArg&& key, TArgs&&... args)
+      {
+        const iterator it = lower_bound(key);
+        if (it != end() && !m_compare(key, it->first))
+        {
+          return std::make_pair(it, false);
+        }
+
+        return std::make_pair(m_values.emplace(it, std::piecewise_construct,
+          std::forward_as_tuple(std::forward<TKeyArg>(key)), std::forward_as_tuple(std::forward<TArgs>(args)...)), true);
+      }
+
+      template<class... TArgs>
+      std::pair<iterator, bool> emplace(TArgs&&... args)
+      {
+        return insert(value_type(std::forward<TArgs>(args)...));
+      }
+
+      std::pair<iterator, bool> insert(const value_type& value)
+      {
+        return try_emplace(value.first, value.second);
+      }
+
+      std::pair<iterator, bool> insert(value_type&& value)
+      {
+        const iterator it = lower_bound(value.first);
+        if (it != end() && !m_compare(value.first, it->first))
+        {
+          return std::make_pair(it, false);
+        }
+
+        return std::make_pair(m_values.insert(it, std::move(value)), true);
+      }
+
+      // Adds many entries with one sort, keys already present win
+      template<class TIterator>
+      void insert(TIterator first, TIterator last)
+      {
+        const size_t oldSize = m_values.size();
+        m_values.insert(m_values.end(), first, last);
+        sort_unique(oldSize);
+      }
+
+      void insert(std::initializer_list<value_type> values)
+      {
+        insert(values.begin(), values.end());
+      }
+
+      template<class TMapped>
+      std::pair<iterator, bool> insert_or_assign(const TKey& key, TMapped&& value)
+      {
+        std::pair<iterator, bool> result = try_emplace(key, std::forward<TMapped>(value));
+        if (!result.second)
+        {
+          result.first->second = std::forward<TMapped>(value);
+        }
+
+        return result;
+      }
+
+      size_t erase(const TKey& key)
+      {
+        const iterator it = find(key);
+        if (it == end())
+        {
+          return 0;
+        }
+
+        m_values.erase(it);
+        return 1;
+      }
+
+      iterator erase(const_iterator position) { return m_values.erase(position); }
+      iterator erase(const_iterator first, const_iterator last) { return m_values.erase(first, last); }
+
+      void clear() { m_values.clear(); }
+
+      void swap(FlatMap& other)
+      {
+        m_values.swap(other.m_values);
+        std::swap(m_compare, other.m_compare);
+      }
+
+      key_compare key_comp() const { return m_compare; }
+
+    private:
+      // Compares entries to keys for the binary searches
+      struct KeyLess
+      {
+        explicit KeyLess(const TCompare& compare) : compare(compare) {}
+
+        bool operator()(const value_type& value, const TKey& key) const { return compare(value.first, key); }
+        bool operator()(const TKey& key, const value_type& value) const { return compare(key, value.first); }
+
+        const TCompare& compare;
+      };
+
+      // Sorts the entries from sortedEnd on, merges them into the sorted
+      // ones before and drops later duplicates of each key
+      void sort_unique(size_t sortedEnd)
+      {
+        const TCompare& compare = m_compare;
+        const auto less = [&compare](const value_type& left, const value_type& right)
+        {
+          return compare(left.first, right.first);
+        };
+
+        std::stable_sort(m_values.begin() + sortedEnd, m_values.end(), less);
+        std::inplace_merge(m_values.begin(), m_values.begin() + sortedEnd, m_values.end(), less);
+        m_values.erase(std::unique(m_values.begin(), m_values.end(),
+          [&compare](const value_type& left, const value_type& right)
+          {
+            return !compare(left.first, right.first);
+          }), m_values.end());
+      }
+
+      container_type m_values;
+      TCompare m_compare;
+    };
+
+    template<class TKey, class TValue, class TCompare, class TAllocator>
+    bool operator==(const FlatMap<TKey, TValue, TCompare, TAllocator>& left,
+      const FlatMap<TKey, TValue, TCompare, TAllocator>& right)
+    {
+      return left.values() == right.values();
+    }
+
+    template<class TKey, class TValue, class TCompare, class TAllocator>
+    bool operator!=(const FlatMap<TKey, TValue, TCompare, TAllocator>& left,
+      const FlatMap<TKey, TValue, TCompare, TAllocator>& right)
+    {
+      return !(left == right);
+    }
+
+    template<class TKey, class TValue, class TCompare, class TAllocator>
+    bool operator<(const FlatMap<TKey, TValue, TCompare, TAllocator>& left,
+      const FlatMap<TKey, TValue, TCompare, TAllocator>& right)
+    {
+      return left.values() < right.values();
+    }
+
+    // Ordered set stored as a sorted array, see FlatMap
+    template<class TKey, class TCompare = std::less<TKey>, class TAllocator = std::allocator<TKey>>
+    class FlatSet
+    {
+    public:
+      using key_type = TKey;
+      using value_type = TKey;
+      using key_compare = TCompare;
+      using allocator_type = TAllocator;
+      using container_type = std::vector<TKey, TAllocator>;
+      using size_type = size_t;
+      using iterator = typename container_type::const_iterator;
+      using const_iterator = typename container_type::const_iterator;
+      using reverse_iterator = typename container_type::const_reverse_iterator;
+      using const_reverse_iterator = typename container_type::const_reverse_iterator;
+
+      FlatSet() = default;
+
+      explicit FlatSet(const TCompare& compare, const TAllocator& allocator = TAllocator()) :
+        m_values(allocator), m_compare(compare)
+      {
+      }
+
+      explicit FlatSet(const TAllocator& allocator) : m_values(allocator) {}
+
+      template<class TIterator>
+      FlatSet(TIterator first, TIterator last, const TCompare& compare = TCompare(),
+        const TAllocator& allocator = TAllocator()) :
+        m_values(first, last, allocator), m_compare(compare)
+      {
+        sort_unique(0);
+      }
+
+      FlatSet(std::initializer_list<TKey> values, const TCompare& compare = TCompare(),
+        const TAllocator& allocator = TAllocator()) :
+        FlatSet(values.begin(), values.end(), compare, allocator)
+      {
+      }
+
+      FlatSet(const FlatSet& other) = default;
+      FlatSet(FlatSet&& other) = default;
+
+      FlatSet(const FlatSet& other, const TAllocator& allocator) :
+        m_values(other.m_values, allocator), m_compare(other.m_compare)
+      {
+      }
+
+      FlatSet& operator=(const FlatSet& other) = default;
+      FlatSet& operator=(FlatSet&& other) = default;
+
+      // Takes values that are already sorted with no duplicates
+      FlatSet(SortedUnique, container_type values, const TCompare& compare = TCompare()) :
+        m_values(std::move(values)), m_compare(compare)
+      {
+      }
+
+      // Iterators, all const as changing a value could break the order
+      const_iterator begin() const { return m_values.begin(); }
+      const_iterator end() const { return m_values.end(); }
+      const_iterator cbegin() const { return m_values.cbegin(); }
+      const_iterator cend() const { return m_values.cend(); }
+      const_reverse_iterator rbegin() const { return m_values.rbegin(); }
+      const_reverse_iterator rend() const { return m_values.rend(); }
+
+      // Capacity
+      bool empty() const { return m_values.empty(); }
+      size_t size() const { return m_values.size(); }
+      size_t capacity() const { return m_values.capacity(); }
+      void reserve(size_t count) { m_values.reserve(count); }
+      void shrink_to_fit() { m_values.shrink_to_fit(); }
+
+      // The sorted values
+      const container_type& values() const { return m_values; }
+
+      allocator_type get_allocator() const { return m_values.get_allocator(); }
+
+      // Lookup
+      const_iterator lower_bound(const TKey& key) const
+      {
+        return std::lower_bound(m_values.begin(), m_values.end(), key, m_compare);
+      }
+
+      const_iterator upper_bound(const TKey& key) const
+      {
+        return std::upper_bound(m_values.begin(), m_values.end(), key, m_compare);
+      }
+
+      std::pair<const_iterator, const_iterator> equal_range(const TKey& key) const
+      {
+        const const_iterator it = find(key);
+        return std::make_pair(it, it == end() ? it : it + 1);
+      }
+
+      const_iterator find(const TKey& key) const
+      {
+        const const_iterator it = lower_bound(key);
+        return it != end() && !m_compare(key, *it) ? it : end();
+      }
+
+      size_t count(const TKey& key) const { return find(key) != end() ? 1 : 0; }
+      bool contains(const TKey& key) const { return find(key) != end(); }
+
+      // Modifiers
+      template<class... TArgs>
+      std::pair<iterator, bool> emplace(TArgs&&... args)
+      {
+        return insert(TKey(std::forward<TArgs>(args)...));
+      }
+
+      std::pair<iterator, bool> insert(const TKey& key)
+      {
+        return insert(TKey(key));
+      }
+
+      std::pair<iterator, bool> insert(TKey&& key)
+      {
+        const const_iterator it = lower_bound(key);
+        if (it != end() && !m_compare(key, *it))
+        {
+          return std::make_pair(it, false);
+        }
+
+        return std::make_pair(const_iterator(m_values.insert(it, std::move(key))), true);
+      }
+
+      // Adds many values with one sort
+      template<class TIterator>
+      void insert(TIterator first, TIterator last)
+      {
+        const size_t oldSize = m_values.size();
+        m_values.insert(m_values.end(), first, last);
+        sort_unique(oldSize);
+      }
+
+      void insert(std::initializer_list<TKey> values)
+      {
+        insert(values.begin(), values.end());
+      }
+
+      size_t erase(const TKey& key)
+      {
+        const const_iterator it = find(key);
+        if (it == end())
+        {
+          return 0;
+        }
+
+        m_values.erase(it);
+        return 1;
+      }
+
+      iterator erase(const_iterator position) { return m_values.erase(position); }
+      iterator erase(const_iterator first, const_iterator last) { return m_values.erase(first, last); }
+
+      void clear() { m_values.clear(); }
+
+      void swap(FlatSet& other)
+      {
+        m_values.swap(other.m_values);
+        std::swap(m_compare, other.m_compare);
+      }
+
+      key_compare key_comp() const { return m_compare; }
+
+    private:
+      // Sorts the values from sortedEnd on, merges them into the sorted ones
+      // before and drops duplicates
+      void sort_unique(size_t sortedEnd)
+      {
+        const TCompare& compare = m_compare;
+        std::stable_sort(m_values.begin() + sortedEnd, m_values.end(), compare);
+        std::inplace_merge(m_values.begin(), m_values.begin() + sortedEnd, m_values.end(), compare);
+        m_values.erase(std::unique(m_values.begin(), m_values.end(),
+          [&compare](const TKey& left, const TKey& right)
+          {
+            return !compare(left, right);
+          }), m_values.end());
+      }
+
+      container_type m_values;
+      TCompare m_compare;
+    };
+
+    template<class TKey, class TCompare, class TAllocator>
+    bool operator==(const FlatSet<TKey, TCompare, TAllocator>& left, const FlatSet<TKey, TCompare, TAllocator>& right)
+    {
+      return left.values() == right.values();
+    }
+
+    template<class TKey, class TCompare, class TAllocator>
+    bool operator!=(const FlatSet<TKey, TCompare, TAllocator>& left, const FlatSet<TKey, TCompare, TAllocator>& right)
+    {
+      return !(left == right);
+    }
+
+    template<class TKey, class TCompare, class TAllocator>
+    bool operator<(const FlatSet<TKey, TCompare, TAllocator>& left, const FlatSet<TKey, TCompare, TAllocator>& right)
+    {
+      return left.values() < right.values();
+    }
+  }
+}
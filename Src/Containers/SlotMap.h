@@ -0,0 +1,233 @@
+/******************************************************************************
+File: SlotMap.h
+Created: 10/20/2026 9:41:02 AM
+Copyright (c) 2017 Turn Tactics
+
+Permission is hereby granted, free of charge, to any person obtaining a copy
+of this software and associated documentation files (the "Software"), to deal
+in the Software without restriction, including without limitation the rights
+to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+copies of the Software, and to permit persons to whom the Software is
+furnished to do so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in
+all copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+SOFTWARE.
+
+Purpose: Defines a slot map, a container that keeps its values packed for fast
+         iteration and hands out generational handles that stay valid while
+         values move around and detect when the value they named is gone.
+
+Author: James Womack
+
+********************************************************************************/
+#pragma once
+
+#include "../Common.h"
+
+#include <cstdint>
+#include <utility>
+
+namespace lse
+{
+  namespace containers
+  {
+    // Names a value in a SlotMap. The generation tells apart values that
+    // lived in the same slot at different times, so a handle to an erased
+    // value never finds whatever replaced it. Default constructed handles
+    // are null and never find anything.
+    struct SlotHandle
+    {
+      static const UInt32 InvalidIndex = 0xFFFFFFFF;
+
+      UInt32 index = InvalidIndex;
+      UInt32 generation = 0;
+
+      // Packs the handle into 64 bits for storing outside the engine
+      std::uint64_t to_bits() const { return (static_cast<std::uint64_t>(generation) << 32) | index; }
+
+      static SlotHandle from_bits(std::uint64_t bits)
+      {
+        SlotHandle handle;
+        handle.index = static_cast<UInt32>(bits & 0xFFFFFFFF);
+        handle.generation = static_cast<UInt32>(bits >> 32);
+        return handle;
+      }
+    };
+
+    inline bool operator==(const SlotHandle& left, const SlotHandle& right)
+    {
+      return left.index == right.index && left.generation == right.generation;
+    }
+
+    inline bool operator!=(const SlotHandle& left, const SlotHandle& right)
+    {
+      return !(left == right);
+    }
+
+    // Stores values densely in one array and reaches them through a table of
+    // slots, so insert, erase and lookup are O(1) and iterating touches only
+    // live values. Erasing moves the last value into the hole, so the order
+    // of values changes and pointers into the map do not survive an erase or
+    // insert, hold handles instead.
+    template<class TValue>
+    class SlotMap
+    {
+    public:
+      using iterator = typename Vector<TValue>::iterator;
+      using const_iterator = typename Vector<TValue>::const_iterator;
+
+      // Constructs a value in place and returns its handle
+      template<class... TArgs>
+      SlotHandle emplace(TArgs&&... args)
+      {
+        m_values.emplace_back(std::forward<TArgs>(args)...);
+
+        UInt32 slotIndex;
+        if (m_freeHead != SlotHandle::InvalidIndex)
+        {
+          slotIndex = m_freeHead;
+          m_freeHead = m_slots[slotIndex].index;
+        }
+        else
+        {
+          slotIndex = static_cast<UInt32>(m_slots.size());
+          m_slots.push_back(Slot());
+        }
+
+        // Occupied slots have odd generations
+        Slot& slot = m_slots[slotIndex];
+        ++slot.generation;
+        slot.index = static_cast<UInt32>(m_values.size() - 1);
+        m_valueSlots.push_back(slotIndex);
+
+        SlotHandle handle;
+        handle.index = slotIndex;
+        handle.generation = slot.generation;
+        return handle;
+      }
+
+      SlotHandle insert(const TValue& value) { return emplace(value); }
+      SlotHandle insert(TValue&& value) { return emplace(std::move(value)); }
+
+      // Removes the value a handle names, returns false if it was already
+      // gone
+      bool erase(SlotHandle handle)
+      {
+        if (!contains(handle))
+        {
+          return false;
+        }
+
+        Slot& slot = m_slots[handle.index];
+        const UInt32 valueIndex = slot.index;
+        const UInt32 lastIndex = static_cast<UInt32>(m_values.size() - 1);
+
+        // Move the last value into the hole and repoint its slot
+        if (valueIndex != lastIndex)
+        {
+          m_values[valueIndex] = std::move(m_values[lastIndex]);
+          m_valueSlots[valueIndex] = m_valueSlots[lastIndex];
+          m_slots[m_valueSlots[valueIndex]].index = valueIndex;
+        }
+
+        m_values.pop_back();
+        m_valueSlots.pop_back();
+
+        ++slot.generation;
+        slot.index = m_freeHead;
+        m_freeHead = handle.index;
+        return true;
+      }
+
+      // Returns if a handle still names a value in the map
+      bool contains(SlotHandle handle) const
+      {
+        return handle.index < m_slots.size() && m_slots[handle.index].generation == handle.generation
+          && (handle.generation & 1) != 0;
+      }
+
+      // Returns the value a handle names, or null if it is gone
+      TValue* get(SlotHandle handle)
+      {
+        return contains(handle) ? &m_values[m_slots[handle.index].index] : nullptr;
+      }
+
+      const TValue* get(SlotHandle handle) const
+      {
+        return contains(handle) ? &m_values[m_slots[handle.index].index] : nullptr;
+      }
+
+      // Returns the handle of the value at a position in iteration order
+      SlotHandle handle_at(size_t position) const
+      {
+        SlotHandle handle;
+        handle.index = m_valueSlots[position];
+        handle.generation = m_slots[handle.index].generation;
+        return handle;
+      }
+
+      // Removes every value, handles to them all become stale
+      void clear()
+      {
+        for (UInt32 slotIndex : m_valueSlots)
+        {
+          Slot& slot = m_slots[slotIndex];
+          ++slot.generation;
+          slot.index = m_freeHead;
+          m_freeHead = slotIndex;
+        }
+
+        m_values.clear();
+        m_valueSlots.clear();
+      }
+
+      void reserve(size_t count)
+      {
+        m_values.reserve(count);
+        m_valueSlots.reserve(count);
+        m_slots.reserve(count);
+      }
+
+      size_t size() const { return m_values.size(); }
+      bool empty() const { return m_values.empty(); }
+
+      // The values packed together in iteration order, size() of them. Only
+      // the values can be changed through these, adding or removing them
+      // would break the slots.
+      TValue* data() { return m_values.data(); }
+      const TValue* data() const { return m_values.data(); }
+      const Vector<TValue>& values() const { return m_values; }
+
+      iterator begin() { return m_values.begin(); }
+      iterator end() { return m_values.end(); }
+      const_iterator begin() const { return m_values.begin(); }
+      const_iterator end() const { return m_values.end(); }
+
+    private:
+      struct Slot
+      {
+        // Odd while the slot holds a value
+        UInt32 generation = 0;
+
+        // Position of the value when occupied, next free slot when not
+        UInt32 index = SlotHandle::InvalidIndex;
+      };
+
+      Vector<TValue> m_values;
+
+      // The slot of each value, parallel to m_values
+      Vector<UInt32> m_valueSlots;
+
+      Vector<Slot> m_slots;
+      UInt32 m_freeHead = SlotHandle::InvalidIndex;
+    };
+  }
+}
@@ -0,0 +1,490 @@
+/******************************************************************************
+File: SmallVector.h
+Created: 10/20/2026 4:52:19 PM
+Copyright (c) 2017 Turn Tactics
+
+Permission is hereby granted, free of charge, to any person obtaining a copy
+of this software and associated documentation files (the "Software"), to deal
+in the Software without restriction, including without limitation the rights
+to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+copies of the Software, and to permit persons to whom the Software is
+furnished to do so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in
+all copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+SOFTWARE.
+
+Purpose: Defines a vector that keeps its first few elements inside itself and
+         only allocates once it grows past them, for the many short lists
+         built every frame.
+
+Author: James Womack
+
+********************************************************************************/
+#pragma once
+
+#include "../Common.h"
+
+#include <algorithm>
+#include <initializer_list>
+#include <iterator>
+#include <memory>
+#include <new>
+#include <stdexcept>
+#include <type_traits>
+#include <utility>
+
+namespace lse
+{
+  namespace containers
+  {
+    // A vector with room for InlineCount elements inside the object itself.
+    // It only touches the heap once it grows past that, so lists that are
+    // usually short cost no allocations. Follows the std::vector interface,
+    // iterators are plain pointers and are invalidated the same way, plus
+    // moving a SmallVector that has not spilled moves its elements one by one
+    // instead of stealing a buffer.
+    template<class TValue, size_t InlineCount>
+    class SmallVector
+    {
+    public:
+      static_assert(InlineCount > 0, "Use Vector when there is no inline storage");
+
+      using value_type = TValue;
+      using size_type = size_t;
+      using difference_type = std::ptrdiff_t;
+      using reference = TValue&;
+      using const_reference = const TValue&;
+      using pointer = TValue*;
+      using const_pointer = const TValue*;
+      using iterator = TValue*;
+      using const_iterator = const TValue*;
+      using reverse_iterator = std::reverse_iterator<iterator>;
+      using const_reverse_iterator = std::reverse_iterator<const_iterator>;
+
+      SmallVector() :
+        m_data(inline_data()), m_size(0), m_capacity(InlineCount)
+      {
+      }
+
+      explicit SmallVector(size_t count) : SmallVector()
+      {
+        resize(count);
+      }
+
+      SmallVector(size_t count, const TValue& value) : SmallVector()
+      {
+        assign(count, value);
+      }
+
+      template<class TIterator, class = typename std::enable_if<!std::is_integral<TIterator>::value>::type>
+      SmallVector(TIterator first, TIterator last) : SmallVector()
+      {
+        assign(first, last);
+      }
+
+      SmallVector(std::initializer_list<TValue> values) : SmallVector()
+      {
+        assign(values.begin(), values.end());
+      }
+
+      SmallVector(const SmallVector& other) : SmallVector()
+      {
+        assign(other.begin(), other.end());
+      }
+
+      SmallVector(SmallVector&& other) noexcept(std::is_nothrow_move_constructible<TValue>::value) :
+        SmallVector()
+      {
+        take(std::move(other));
+      }
+
+      ~SmallVector()
+      {
+        clear();
+        release();
+      }
+
+      SmallVector& operator=(const SmallVector& other)
+      {
+        if (this != &other)
+        {
+          assign(other.begin(), other.end());
+        }
+
+        return *this;
+      }
+
+      SmallVector& operator=(SmallVector&& other)
+      {
+        if (this != &other)
+        {
+          clear();
+          take(std::move(other));
+        }
+
+        return *this;
+      }
+
+      SmallVector& operator=(std::initializer_list<TValue> values)
+      {
+        assign(values.begin(), values.end());
+        return *this;
+      }
+
+      void assign(size_t count, const TValue& value)
+      {
+        // Copy first in case value lives in this vector
+        const TValue copy = value;
+        clear();
+        reserve(count);
+        std::uninitialized_fill_n(m_data, count, copy);
+        m_size = count;
+      }
+
+      template<class TIterator, class = typename std::enable_if<!std::is_integral<TIterator>::value>::type>
+      void assign(TIterator first, TIterator last)
+      {
+        clear();
+        for (; first != last; ++first)
+        {
+          emplace_back(*first);
+        }
+      }
+
+      void assign(std::initializer_list<TValue> values)
+      {
+        assign(values.begin(), values.end());
+      }
+
+      // Element access
+      TValue& operator[](size_t index) { return m_data[index]; }
+      const TValue& operator[](size_t index) const { return m_data[index]; }
+
+      TValue& at(size_t index)
+      {
+        check_index(index);
+        return m_data[index];
+      }
+
+      const TValue& at(size_t index) const
+      {
+        check_index(index);
+        return m_data[index];
+      }
+
+      TValue& front() { return m_data[0]; }
+      const TValue& front() const { return m_data[0]; }
+      TValue& back() { return m_data[m_size - 1]; }
+      const TValue& back() const { return m_data[m_size - 1]; }
+      TValue* data() { return m_data; }
+      const TValue* data() const { return m_data; }
+
+      // Iterators
+      iterator begin() { return m_data; }
+      iterator end() { return m_data + m_size; }
+      const_iterator begin() const { return m_data; }
+      const_iterator end() const { return m_data + m_size; }
+      const_iterator cbegin() const { return m_data; }
+      const_iterator cend() const { return m_data + m_size; }
+      reverse_iterator rbegin() { return reverse_iterator(end()); }
+      reverse_iterator rend() { return reverse_iterator(begin()); }
+      const_reverse_iterator rbegin() const { return const_reverse_iterator(end()); }
+      const_reverse_iterator rend() const { return const_reverse_iterator(begin()); }
+
+      // Capacity
+      bool empty() const { return m_size == 0; }
+      size_t size() const { return m_size; }
+      size_t capacity() const { return m_capacity; }
+      size_t max_size() const { return std::allocator<TValue>().max_size(); }
+
+      // Returns if the elements are still in the inline storage
+      bool is_inline() const { return m_data == inline_data(); }
+
+      void reserve(size_t count)
+      {
+        if (count > m_capacity)
+        {
+          reallocate(count);
+        }
+      }
+
+      // Moves the elements back inline when they fit, otherwise trims the
+      // heap buffer to size
+      void shrink_to_fit()
+      {
+        if (!is_inline() && m_size < m_capacity)
+        {
+          reallocate(m_size);
+        }
+      }
+
+      // Modifiers
+      void clear()
+      {
+        destroy(m_data, m_data + m_size);
+        m_size = 0;
+      }
+
+      template<class... TArgs>
+      TValue& emplace_back(TArgs&&... args)
+      {
+        if (m_size < m_capacity)
+        {
+          new (m_data + m_size) TValue(std::forward<TArgs>(args)...);
+        }
+        else
+        {
+          // Build the new element before moving the old ones, the arguments
+          // may refer to elements of this vector
+          const size_t capacity = grown_capacity(m_size + 1);
+          TValue* data = allocate(capacity);
+          new (data + m_size) TValue(std::forward<TArgs>(args)...);
+          move_to(data, capacity);
+        }
+
+        return m_data[m_size++];
+      }
+
+      void push_back(const TValue& value) { emplace_back(value); }
+      void push_back(TValue&& value) { emplace_back(std::move(value)); }
+
+      void pop_back()
+      {
+        --m_size;
+        m_data[m_size].~TValue();
+      }
+
+      template<class... TArgs>
+      iterator emplace(const_iterator position, TArgs&&... args)
+      {
+        const size_t index = static_cast<size_t>(position - m_data);
+        emplace_back(std::forward<TArgs>(args)...);
+        std::rotate(m_data + index, m_data + m_size - 1, m_data + m_size);
+        return m_data + index;
+      }
+
+      iterator insert(const_iterator position, const TValue& value) { return emplace(position, value); }
+      iterator insert(const_iterator position, TValue&& value) { return emplace(position, std::move(value)); }
+
+      iterator insert(const_iterator position, size_t count, const TValue& value)
+      {
+        const size_t index = static_cast<size_t>(position - m_data);
+        const size_t oldSize = m_size;
+        const TValue copy = value;
+        reserve(m_size + count);
+        for (size_t i = 0; i < count; ++i)
+        {
+          emplace_back(copy);
+        }
+
+        std::rotate(m_data + index, m_data + oldSize, m_data + m_size);
+        return m_data + index;
+      }
+
+      template<class TIterator, class = typename std::enable_if<!std::is_integral<TIterator>::value>::type>
+      iterator insert(const_iterator position, TIterator first, TIterator last)
+      {
+        const size_t index = static_cast<size_t>(position - m_data);
+        const size_t oldSize = m_size;
+        for (; first != last; ++first)
+        {
+          emplace_back(*first);
+        }
+
+        std::rotate(m_data + index, m_data + oldSize, m_data + m_size);
+        return m_data + index;
+      }
+
+      iterator insert(const_iterator position, std::initializer_list<TValue> values)
+      {
+        return insert(position, values.begin(), values.end());
+      }
+
+      iterator erase(const_iterator position)
+      {
+        return erase(position, position + 1);
+      }
+
+      iterator erase(const_iterator first, const_iterator last)
+      {
+        TValue* start = m_data + (first - m_data);
+        TValue* finish = m_data + (last - m_data);
+        if (start != finish)
+        {
+          TValue* newEnd = std::move(finish, end(), start);
+          destroy(newEnd, end());
+          m_size = static_cast<size_t>(newEnd - m_data);
+        }
+
+        return start;
+      }
+
+      void resize(size_t count)
+      {
+        if (count < m_size)
+        {
+          destroy(m_data + count, end());
+          m_size = count;
+          return;
+        }
+
+        reserve(count);
+        while (m_size < count)
+        {
+          new (m_data + m_size) TValue();
+          ++m_size;
+        }
+      }
+
+      void resize(size_t count, const TValue& value)
+      {
+        if (count < m_size)
+        {
+          destroy(m_data + count, end());
+          m_size = count;
+          return;
+        }
+
+        const TValue copy = value;
+        reserve(count);
+        std::uninitialized_fill(end(), m_data + count, copy);
+        m_size = count;
+      }
+
+      void swap(SmallVector& other)
+      {
+        SmallVector temporary(std::move(other));
+        other = std::move(*this);
+        *this = std::move(temporary);
+      }
+
+    private:
+      TValue* inline_data() { return reinterpret_cast<TValue*>(&m_inline); }
+      const TValue* inline_data() const { return reinterpret_cast<const TValue*>(&m_inline); }
+
+      static TValue* allocate(size_t count)
+      {
+        return std::allocator<TValue>().allocate(count);
+      }
+
+      static void destroy(TValue* first, TValue* last)
+      {
+        for (; first != last; ++first)
+        {
+          first->~TValue();
+        }
+      }
+
+      void check_index(size_t index) const
+      {
+        if (index >= m_size)
+        {
+          throw std::out_of_range("SmallVector index out of range");
+        }
+      }
+
+      size_t grown_capacity(size_t required) const
+      {
+        return std::max(m_capacity * 2, required);
+      }
+
+      // Frees the heap buffer if there is one, the elements must already be
+      // destroyed or moved out
+      void release()
+      {
+        if (!is_inline())
+        {
+          std::allocator<TValue>().deallocate(m_data, m_capacity);
+          m_data = inline_data();
+          m_capacity = InlineCount;
+        }
+      }
+
+      // Moves the elements into data, which has room for capacity elements,
+      // and makes it the storage
+      void move_to(TValue* data, size_t capacity)
+      {
+        std::uninitialized_move(m_data, m_data + m_size, data);
+        destroy(m_data, m_data + m_size);
+        release();
+        m_data = data;
+        m_capacity = capacity;
+      }
+
+      // Moves the elements to storage for capacity elements, going back
+      // inline when they fit
+      void reallocate(size_t capacity)
+      {
+        if (capacity <= InlineCount)
+        {
+          if (!is_inline())
+          {
+            TValue* heap = m_data;
+            const size_t heapCapacity = m_capacity;
+            std::uninitialized_move(heap, heap + m_size, inline_data());
+            destroy(heap, heap + m_size);
+            std::allocator<TValue>().deallocate(heap, heapCapacity);
+            m_data = inline_data();
+            m_capacity = InlineCount;
+          }
+          return;
+        }
+
+        move_to(allocate(capacity), capacity);
+      }
+
+      // Takes the elements of other, which is left empty. This must be empty
+      // with nothing of its own to free on the heap unless other spilled.
+      void take(SmallVector&& other)
+      {
+        if (!other.is_inline())
+        {
+          release();
+          m_data = other.m_data;
+          m_size = other.m_size;
+          m_capacity = other.m_capacity;
+          other.m_data = other.inline_data();
+          other.m_size = 0;
+          other.m_capacity = InlineCount;
+          return;
+        }
+
+        reserve(other.m_size);
+        std::uninitialized_move(other.begin(), other.end(), m_data);
+        m_size = other.m_size;
+        other.clear();
+      }
+
+      TValue* m_data;
+      size_t m_size;
+      size_t m_capacity;
+      typename std::aligned_storage<sizeof(TValue) * InlineCount, alignof(TValue)>::type m_inline;
+    };
+
+    template<class TValue, size_t InlineCount>
+    bool operator==(const SmallVector<TValue, InlineCount>& left, const SmallVector<TValue, InlineCount>& right)
+    {
+      return left.size() == right.size() && std::equal(left.begin(), left.end(), right.begin());
+    }
+
+    template<class TValue, size_t InlineCount>
+    bool operator!=(const SmallVector<TValue, InlineCount>& left, const SmallVector<TValue, InlineCount>& right)
+    {
+      return !(left == right);
+    }
+
+    template<class TValue, size_t InlineCount>
+    bool operator<(const SmallVector<TValue, InlineCount>& left, const SmallVector<TValue, InlineCount>& right)
+    {
+      return std::lexicographical_compare(left.begin(), left.end(), right.begin(), right.end());
+    }
+  }
+}
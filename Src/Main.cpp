@@ -4,16 +4,108 @@ and may not be redistributed without written permission.*/
 //Using SDL, SDL_image, standard IO, and strings
 #include <SDL.h>
 #include <SDL_image.h>
+#include <fstream>
+#include <iostream>
 #include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
 #include <string>
+#include "Render/DirtyRegions.h"
+#include "Render/RenderCommandList.h"
+#include "Render/Renderer.h"
+#include "Render/Texture.h"
+#include "Render/TextureAtlas.h"
+#include "Render/TextureManager.h"
+#include "Util/Benchmarks.h"
+#include "Util/CrashLogRing.h"
+#include "Util/FrameArena.h"
+#include "Util/GameLoop.h"
+#include "Util/JobSystem.h"
+#include "Util/Logger.h"
+#include "Util/MemoryTracker.h"
+#include "Util/Profiler.h"
+#include "Util/Telemetry.h"
+#include "Util/TripleBuffer.h"
 
 //Screen dimension constants
 const int SCREEN_WIDTH = 640;
 const int SCREEN_HEIGHT = 480;
 
+//Command line options
+struct Options
+{
+  //Simulate matches with no window or rendering
+  bool headless = false;
+
+  //Number of matches to simulate in headless mode
+  Uint32 matches = 100;
+
+  //Ticks in a simulated match, used until match rules can end a match
+  Uint32 matchTicks = 3600;
+
+  //Atlas file to pack the images below into, empty to run the game
+  std::string atlasPath;
+  lse::containers::Vector<std::string> atlasImages;
+
+  //Write the log as binary records, read with --decode-log
+  bool binaryLog = false;
+
+  //Runtime log filters in the order given, Count applies to every category
+  lse::containers::Vector<std::pair<lse::LogCategory, lse::LogLevel>> logLevels;
+
+  //Binary log to turn into text instead of running the game, and the text
+  //file to write, empty for the console
+  std::string decodeLogPath;
+  std::string decodeOutputPath;
+
+  //Crash log ring to read back instead of running the game, and the text
+  //file to write, empty for the console
+  std::string recoverLogPath;
+  std::string recoverOutputPath;
+
+  //Record engine counters while the game runs, and where to
+  bool recordTelemetry = false;
+  lse::TelemetrySettings telemetry;
+
+  //Binary telemetry file to turn into CSV instead of running the game
+  std::string telemetryInputPath;
+  std::string telemetryOutputPath;
+
+  //Run the allocator or hash map benchmark instead of the game
+  bool benchPool = false;
+  bool benchHashMap = false;
+};
+
+//Reads the command line into options, returns false on a bad argument
+bool parseOptions(int argc, char* args[], Options& options);
+
 //Starts up SDL and creates window
 bool init();
 
+//Starts up SDL without video or image loading
+bool initHeadless();
+
+//Simulates matches back to back and reports matches per second
+void runHeadless(const Options& options);
+
+//Packs loose images into an atlas on disk
+bool packAtlas(const Options& options);
+
+//Turns a binary log into text
+bool decodeLog(const Options& options);
+
+//Prints the messages left in a crash log ring
+bool recoverLog(const Options& options);
+
+//Turns a binary telemetry file into CSV
+bool convertTelemetry(const Options& options);
+
+//Registers the telemetry columns so the CSV header has every one of them
+void registerTelemetry();
+
+//Samples engine counters for the telemetry file, once per rendered frame
+void sampleTelemetry();
+
 //Loads media
 bool loadMedia();
 
@@ -21,17 +113,154 @@ bool loadMedia();
 void close();
 
 //Loads individual image
-SDL_Surface* loadSurface(std::string path);
+SDL_Surface* loadSurface(const std::string& path);
+
+//Worker threads shared by every engine system
+lse::JobSystem* gJobSystem = NULL;
 
 //The window we'll be rendering to
 SDL_Window* gWindow = NULL;
 
-//The surface contained by the window
+//The batched renderer for the window, invalid when no accelerated
+//renderer could be created
+lse::Renderer gRenderer;
+
+//The surface contained by the window, only used without a renderer
 SDL_Surface* gScreenSurface = NULL;
 
+//Regions of the window surface that need redrawing and presenting
+lse::DirtyRegions gDirtyRegions;
+
+//Render snapshots published by the simulation thread each tick
+lse::TripleBuffer<lse::RenderCommandList> gSnapshots;
+
+//Cache of every texture loaded through the renderer
+lse::TextureManager* gTextures = NULL;
+
+//Scratch memory for the render thread, reset after every rendered frame
+lse::LinearArena gFrameArena;
+
+//Telemetry columns, registered before recording starts
+struct TelemetryCounters
+{
+  lse::telemetry::CounterId frameTime;
+  lse::telemetry::CounterId frameArena;
+  lse::telemetry::CounterId drawCalls;
+  lse::telemetry::CounterId textureSwitches;
+  lse::telemetry::CounterId textureMemory;
+
+  //Live bytes charged to each memory tag, pools included
+  lse::telemetry::CounterId memory[lse::to_integral(lse::MemoryTag::Count)];
+};
+TelemetryCounters gCounters;
+
 //Current displayed PNG image
+lse::TextureHandle gPNGTexture;
+
+//Current displayed PNG image for the window surface fallback
 SDL_Surface* gPNGSurface = NULL;
 
+bool parseOptions(int argc, char* args[], Options& options)
+{
+  for (int i = 1; i < argc; ++i)
+  {
+    if (strcmp(args[i], "--headless") == 0)
+    {
+      options.headless = true;
+    }
+    else if (strcmp(args[i], "--matches") == 0 && i + 1 < argc)
+    {
+      options.matches = static_cast<Uint32>(strtoul(args[++i], NULL, 10));
+    }
+    else if (strcmp(args[i], "--match-ticks") == 0 && i + 1 < argc)
+    {
+      options.matchTicks = static_cast<Uint32>(strtoul(args[++i], NULL, 10));
+    }
+    else if (strcmp(args[i], "--binary-log") == 0)
+    {
+      options.binaryLog = true;
+    }
+    //Either LEVEL for every category or CATEGORY=LEVEL
+    else if (strcmp(args[i], "--log-level") == 0 && i + 1 < argc)
+    {
+      const std::string filter = args[++i];
+      const size_t split = filter.find('=');
+
+      lse::LogCategory category = lse::LogCategory::Count;
+      lse::LogLevel level = lse::LogLevel::Trace;
+      if ((split != std::string::npos && !lse::logger::parse_category(filter.substr(0, split).c_str(), category)) ||
+        !lse::logger::parse_level(filter.c_str() + (split == std::string::npos ? 0 : split + 1), level))
+      {
+        printf("Unknown log filter %s!\n", filter.c_str());
+        return false;
+      }
+
+      options.logLevels.emplace_back(category, level);
+    }
+    else if (strcmp(args[i], "--decode-log") == 0 && i + 1 < argc)
+    {
+      options.decodeLogPath = args[++i];
+      if (i + 1 < argc)
+      {
+        options.decodeOutputPath = args[++i];
+      }
+    }
+    else if (strcmp(args[i], "--recover-log") == 0 && i + 1 < argc)
+    {
+      options.recoverLogPath = args[++i];
+      if (i + 1 < argc)
+      {
+        options.recoverOutputPath = args[++i];
+      }
+    }
+    else if ((strcmp(args[i], "--telemetry") == 0 || strcmp(args[i], "--telemetry-binary") == 0) && i + 1 < argc)
+    {
+      options.recordTelemetry = true;
+      options.telemetry.binary = strcmp(args[i], "--telemetry-binary") == 0;
+      options.telemetry.path = args[++i];
+    }
+    else if (strcmp(args[i], "--telemetry-rate") == 0 && i + 1 < argc)
+    {
+      options.telemetry.sampleInterval = static_cast<Uint32>(strtoul(args[++i], NULL, 10));
+    }
+    else if (strcmp(args[i], "--telemetry-csv") == 0 && i + 2 < argc)
+    {
+      options.telemetryInputPath = args[++i];
+      options.telemetryOutputPath = args[++i];
+    }
+    else if (strcmp(args[i], "--bench-pool") == 0)
+    {
+      options.benchPool = true;
+    }
+    else if (strcmp(args[i], "--bench-hash-map") == 0)
+    {
+      options.benchHashMap = true;
+    }
+    //Every argument after the atlas path is an image to pack
+    else if (strcmp(args[i], "--pack-atlas") == 0 && i + 2 < argc)
+    {
+      options.atlasPath = args[++i];
+      options.atlasImages.assign(args + i + 1, args + argc);
+      break;
+    }
+    else
+    {
+      printf("Unknown argument %s!\n", args[i]);
+      printf("Usage: %s [--binary-log] [--log-level [CATEGORY=]LEVEL]...\n", args[0]);
+      printf("       [--telemetry FILE.csv | --telemetry-binary FILE.tlm] [--telemetry-rate FRAMES]\n");
+      printf("       [--headless [--matches N] [--match-ticks N]]\n");
+      printf("       %s --pack-atlas OUTPUT.atlas IMAGE...\n", args[0]);
+      printf("       %s --decode-log GAME.lselog [OUTPUT.log]\n", args[0]);
+      printf("       %s --recover-log GAME.logring[.crash] [OUTPUT.log]\n", args[0]);
+      printf("       %s --telemetry-csv FILE.tlm OUTPUT.csv\n", args[0]);
+      printf("       %s --bench-pool | --bench-hash-map\n", args[0]);
+      return false;
+    }
+  }
+
+  return true;
+}
+
 bool init()
 {
   //Initialization flag
@@ -40,7 +269,7 @@ bool init()
   //Initialize SDL
   if (SDL_Init(SDL_INIT_VIDEO) < 0)
   {
-    printf("SDL could not initialize! SDL Error: %s\n", SDL_GetError());
+    LSE_LOG_ERROR(General, "SDL could not initialize! SDL Error: %s", SDL_GetError());
     success = false;
   }
   else
@@ -49,7 +278,7 @@ bool init()
     gWindow = SDL_CreateWindow("SDL Tutorial", SDL_WINDOWPOS_UNDEFINED, SDL_WINDOWPOS_UNDEFINED, SCREEN_WIDTH, SCREEN_HEIGHT, SDL_WINDOW_SHOWN);
     if (gWindow == NULL)
     {
-      printf("Window could not be created! SDL Error: %s\n", SDL_GetError());
+      LSE_LOG_ERROR(Render, "Window could not be created! SDL Error: %s", SDL_GetError());
       success = false;
     }
     else
@@ -58,13 +287,22 @@ bool init()
       int imgFlags = IMG_INIT_PNG;
       if (!(IMG_Init(imgFlags) & imgFlags))
       {
-        printf("SDL_image could not initialize! SDL_image Error: %s\n", IMG_GetError());
+        LSE_LOG_ERROR(Render, "SDL_image could not initialize! SDL_image Error: %s", IMG_GetError());
         success = false;
       }
-      else
+      //Create the renderer for the window
+      else if (!gRenderer.init(gWindow))
       {
+        LSE_LOG_WARNING(Render, "Accelerated renderer could not be created, using window surface! SDL Error: %s", SDL_GetError());
+
         //Get window surface
         gScreenSurface = SDL_GetWindowSurface(gWindow);
+        gDirtyRegions.resize(gScreenSurface->w, gScreenSurface->h);
+      }
+      else
+      {
+        //Sort each frame's draws in its scratch memory
+        gRenderer.set_frame_arena(&gFrameArena);
       }
     }
   }
@@ -72,16 +310,208 @@ bool init()
   return success;
 }
 
+bool initHeadless()
+{
+  //Only the event queue is needed so the process can still be told to quit
+  if (SDL_Init(SDL_INIT_EVENTS) < 0)
+  {
+    LSE_LOG_ERROR(General, "SDL could not initialize! SDL Error: %s", SDL_GetError());
+    return false;
+  }
+
+  return true;
+}
+
+void runHeadless(const Options& options)
+{
+  //Runs ticks back to back with nothing drawn
+  lse::GameLoop loop;
+
+  Uint32 matchesRun = 0;
+  Uint32 matchTick = 0;
+
+  loop.on_event([&loop](const SDL_Event& e)
+  {
+    //User requests quit
+    if (e.type == SDL_QUIT)
+    {
+      loop.quit();
+    }
+  });
+
+  loop.on_update([&](Float64)
+  {
+    //A match is over once it has run its ticks
+    if (++matchTick >= options.matchTicks)
+    {
+      matchTick = 0;
+      if (++matchesRun >= options.matches)
+      {
+        loop.quit();
+      }
+    }
+  });
+
+  const Uint64 start = SDL_GetPerformanceCounter();
+  if (options.matches > 0 && options.matchTicks > 0)
+  {
+    loop.run_uncapped();
+  }
+  const Float64 seconds = static_cast<Float64>(SDL_GetPerformanceCounter() - start) / SDL_GetPerformanceFrequency();
+
+  printf("Simulated %u matches (%" SDL_PRIu64 " ticks) in %.3f s, %.1f matches/s\n",
+    matchesRun, loop.tick_count(), seconds, seconds > 0.0 ? matchesRun / seconds : 0.0);
+}
+
+bool packAtlas(const Options& options)
+{
+  //Initialize PNG loading and saving
+  int imgFlags = IMG_INIT_PNG;
+  if (!(IMG_Init(imgFlags) & imgFlags))
+  {
+    LSE_LOG_ERROR(Render, "SDL_image could not initialize! SDL_image Error: %s", IMG_GetError());
+    return false;
+  }
+
+  lse::AtlasBuilder builder;
+  for (const std::string& image : options.atlasImages)
+  {
+    //Frames are named after their file without directory or extension
+    std::string name = image.substr(image.find_last_of("/\\") + 1);
+    name = name.substr(0, name.find_last_of('.'));
+
+    if (!builder.add_file(name, image))
+    {
+      return false;
+    }
+  }
+
+  if (!builder.build() || !builder.save(options.atlasPath))
+  {
+    return false;
+  }
+
+  printf("Packed %u images into %u pages\n", static_cast<unsigned>(builder.frames().size()), static_cast<unsigned>(builder.pages().size()));
+  return true;
+}
+
+bool decodeLog(const Options& options)
+{
+  if (options.decodeOutputPath.empty())
+  {
+    return lse::logger::decode(options.decodeLogPath, std::cout);
+  }
+
+  std::ofstream output(options.decodeOutputPath, std::ios::out | std::ios::trunc);
+  if (!output.is_open())
+  {
+    printf("Unable to open %s!\n", options.decodeOutputPath.c_str());
+    return false;
+  }
+
+  return lse::logger::decode(options.decodeLogPath, output);
+}
+
+bool recoverLog(const Options& options)
+{
+  if (options.recoverOutputPath.empty())
+  {
+    return lse::CrashLogRing::recover(options.recoverLogPath, std::cout);
+  }
+
+  std::ofstream output(options.recoverOutputPath, std::ios::out | std::ios::trunc);
+  if (!output.is_open())
+  {
+    printf("Unable to open %s!\n", options.recoverOutputPath.c_str());
+    return false;
+  }
+
+  return lse::CrashLogRing::recover(options.recoverLogPath, output);
+}
+
+bool convertTelemetry(const Options& options)
+{
+  std::ofstream output(options.telemetryOutputPath, std::ios::out | std::ios::trunc);
+  if (!output.is_open())
+  {
+    printf("Unable to open %s!\n", options.telemetryOutputPath.c_str());
+    return false;
+  }
+
+  return lse::telemetry::convert_to_csv(options.telemetryInputPath, output);
+}
+
+void registerTelemetry()
+{
+  gCounters.frameTime = lse::telemetry::register_counter("Frame Time (ms)");
+  gCounters.frameArena = lse::telemetry::register_counter("Frame Arena (bytes)");
+  gCounters.drawCalls = lse::telemetry::register_counter("Draw Calls");
+  gCounters.textureSwitches = lse::telemetry::register_counter("Texture Switches");
+  gCounters.textureMemory = lse::telemetry::register_counter("Texture Memory (bytes)");
+
+  //Counter names have to outlive recording
+  static std::string memoryNames[lse::to_integral(lse::MemoryTag::Count)];
+  for (UInt8 tag = 0; tag < lse::to_integral(lse::MemoryTag::Count); ++tag)
+  {
+    memoryNames[tag] = std::string("Memory ") + lse::memory::tag_name(static_cast<lse::MemoryTag>(tag)) + " (bytes)";
+    gCounters.memory[tag] = lse::telemetry::register_counter(memoryNames[tag].c_str());
+  }
+}
+
+void sampleTelemetry()
+{
+  static Uint64 lastFrame = SDL_GetPerformanceCounter();
+  const Uint64 now = SDL_GetPerformanceCounter();
+
+  if (lse::telemetry::is_running())
+  {
+    lse::telemetry::set(gCounters.frameTime, (now - lastFrame) * 1000.0 / SDL_GetPerformanceFrequency());
+    lse::telemetry::set(gCounters.frameArena, static_cast<Float64>(gFrameArena.last_frame_peak()));
+    if (gRenderer.is_valid())
+    {
+      lse::telemetry::set(gCounters.drawCalls, gRenderer.stats().drawCalls);
+      lse::telemetry::set(gCounters.textureSwitches, gRenderer.stats().textureSwitches);
+    }
+    if (gTextures != NULL)
+    {
+      lse::telemetry::set(gCounters.textureMemory, static_cast<Float64>(gTextures->video_bytes()));
+    }
+
+    for (UInt8 tag = 0; tag < lse::to_integral(lse::MemoryTag::Count); ++tag)
+    {
+      lse::telemetry::set(gCounters.memory[tag], static_cast<Float64>(lse::memory::stats(static_cast<lse::MemoryTag>(tag)).liveBytes));
+    }
+  }
+
+  lastFrame = now;
+  lse::telemetry::end_frame();
+}
+
 bool loadMedia()
 {
   //Loading success flag
   bool success = true;
 
-  //Load PNG surface
-  gPNGSurface = loadSurface("Res/loaded.png");
-  if (gPNGSurface == NULL)
+  //Load PNG texture, or surface when there is no renderer
+  if (gRenderer.is_valid())
+  {
+    gTextures = new lse::TextureManager(gRenderer, gJobSystem);
+
+    //Catch textures pinned past the cache budget during development
+    lse::memory::set_budget(lse::MemoryTag::Texture, gTextures->budget());
+
+    //Decode every image on the workers, only the uploads happen here
+    lse::containers::Vector<lse::TextureHandle> textures = gTextures->load_all({ "Res/loaded.png" });
+    gPNGTexture = textures[0];
+  }
+  else
+  {
+    gPNGSurface = loadSurface("Res/loaded.png");
+  }
+
+  if (!gPNGTexture && gPNGSurface == NULL)
   {
-    printf("Failed to load PNG image!\n");
+    LSE_LOG_ERROR(Render, "Failed to load PNG image!");
     success = false;
   }
 
@@ -91,19 +521,38 @@ bool loadMedia()
 void close()
 {
   //Free loaded image
+  gPNGTexture.release();
   SDL_FreeSurface(gPNGSurface);
   gPNGSurface = NULL;
 
+  //Free every cached texture
+  delete gTextures;
+  gTextures = NULL;
+
+  //Destroy renderer
+  gRenderer.shutdown();
+
   //Destroy window
   SDL_DestroyWindow(gWindow);
   gWindow = NULL;
 
+  //Finish outstanding jobs and stop the workers
+  delete gJobSystem;
+  gJobSystem = NULL;
+
   //Quit SDL subsystems
   IMG_Quit();
   SDL_Quit();
+
+  //Everything tracked should have been freed by now
+  lse::memory::report_leaks();
+
+  //Write out the rest of the telemetry and the log
+  lse::telemetry::stop();
+  lse::logger::stop();
 }
 
-SDL_Surface* loadSurface(std::string path)
+SDL_Surface* loadSurface(const std::string& path)
 {
   //The final optimized image
   SDL_Surface* optimizedSurface = NULL;
@@ -112,7 +561,7 @@ SDL_Surface* loadSurface(std::string path)
   SDL_Surface* loadedSurface = IMG_Load(path.c_str());
   if (loadedSurface == NULL)
   {
-    printf("Unable to load image %s! SDL_image Error: %s\n", path.c_str(), IMG_GetError());
+    LSE_LOG_ERROR(Render, "Unable to load image %s! SDL_image Error: %s", path.c_str(), IMG_GetError());
   }
   else
   {
@@ -120,7 +569,7 @@ SDL_Surface* loadSurface(std::string path)
     optimizedSurface = SDL_ConvertSurface(loadedSurface, gScreenSurface->format, NULL);
     if (optimizedSurface == NULL)
     {
-      printf("Unable to optimize image %s! SDL Error: %s\n", path.c_str(), SDL_GetError());
+      LSE_LOG_ERROR(Render, "Unable to optimize image %s! SDL Error: %s", path.c_str(), SDL_GetError());
     }
 
     //Get rid of old loaded surface
@@ -132,45 +581,213 @@ SDL_Surface* loadSurface(std::string path)
 
 int main(int argc, char* args[])
 {
+  Options options;
+  if (!parseOptions(argc, args, options))
+  {
+    return 1;
+  }
+
+  //Decode a binary log offline instead of running the game
+  if (!options.decodeLogPath.empty())
+  {
+    return decodeLog(options) ? 0 : 1;
+  }
+
+  //Measure allocator throughput instead of running the game
+  if (options.benchPool)
+  {
+    lse::benchmarks::run_pool_benchmark();
+    return 0;
+  }
+
+  //Compare the engine hash map with the standard one instead of running the game
+  if (options.benchHashMap)
+  {
+    lse::benchmarks::run_hash_map_benchmark();
+    return 0;
+  }
+
+  //Convert recorded telemetry offline instead of running the game
+  if (!options.telemetryInputPath.empty())
+  {
+    return convertTelemetry(options) ? 0 : 1;
+  }
+
+  //Read back the log ring of a crashed run instead of running the game
+  if (!options.recoverLogPath.empty())
+  {
+    return recoverLog(options) ? 0 : 1;
+  }
+
+  //Write the log on a background thread, messages before this print directly.
+  //The newest messages are also kept in a ring that survives a crash.
+  lse::LoggerSettings logSettings;
+  logSettings.crashRingPath = "game.logring";
+  if (options.binaryLog)
+  {
+    logSettings.binary = true;
+    logSettings.path = "game.lselog";
+  }
+  lse::logger::start(logSettings);
+
+  for (const auto& filter : options.logLevels)
+  {
+    if (filter.first == lse::LogCategory::Count)
+    {
+      lse::logger::set_level(filter.second);
+    }
+    else
+    {
+      lse::logger::set_category_level(filter.first, filter.second);
+    }
+  }
+
+  //Record engine counters every few frames when asked to
+  if (options.recordTelemetry)
+  {
+    registerTelemetry();
+    lse::telemetry::start(options.telemetry);
+  }
+
+  //Build an atlas offline instead of running the game
+  if (!options.atlasPath.empty())
+  {
+    const bool packed = packAtlas(options);
+    close();
+    return packed ? 0 : 1;
+  }
+
+  //Start the worker threads
+  gJobSystem = new lse::JobSystem();
+
+  if (options.headless)
+  {
+    //Start up SDL without a window, scripted runs need to see a failure
+    bool success = initHeadless();
+    if (!success)
+    {
+      LSE_LOG_ERROR(General, "Failed to initialize!");
+    }
+    else
+    {
+      runHeadless(options);
+    }
+
+    close();
+    return success ? 0 : 1;
+  }
+
   //Start up SDL and create window
   if (!init())
   {
-    printf("Failed to initialize!\n");
+    LSE_LOG_ERROR(General, "Failed to initialize!");
   }
   else
   {
     //Load media
     if (!loadMedia())
     {
-      printf("Failed to load media!\n");
+      LSE_LOG_ERROR(General, "Failed to load media!");
     }
     else
     {
-      //Main loop flag
-      bool quit = false;
+      //Runs fixed ticks on a simulation thread, paces frames and sleeps
+      //while the screen is static
+      lse::GameLoop loop;
 
-      //Event handler
-      SDL_Event e;
+      //Handle events on queue
+      loop.on_event([&loop](const SDL_Event& e)
+      {
+        //User requests quit
+        if (e.type == SDL_QUIT)
+        {
+          loop.quit();
+        }
+        //Window surface contents were lost or replaced
+        else if (e.type == SDL_WINDOWEVENT && gScreenSurface != NULL
+          && (e.window.event == SDL_WINDOWEVENT_EXPOSED || e.window.event == SDL_WINDOWEVENT_SIZE_CHANGED))
+        {
+          gScreenSurface = SDL_GetWindowSurface(gWindow);
+          gDirtyRegions.resize(gScreenSurface->w, gScreenSurface->h);
+        }
+#if LSE_PROFILER
+        //Save a trace of the last few seconds
+        else if (e.type == SDL_KEYDOWN && e.key.keysym.sym == SDLK_F12)
+        {
+          if (lse::profiler::export_chrome_trace("profile_trace.json", 300))
+          {
+            LSE_LOG_INFO(General, "Saved profile trace to profile_trace.json");
+          }
+        }
+#endif
+      });
 
-      //While application is running
-      while (!quit)
+      loop.on_update([](Float64)
       {
-        //Handle events on queue
-        while (SDL_PollEvent(&e) != 0)
+        LSE_PROFILE_ZONE("Update");
+
+        //Build this tick's snapshot of what should be on screen
+        lse::RenderCommandList& snapshot = gSnapshots.write_buffer();
+        snapshot.clear();
+
+        //Queue the PNG image
+        if (gPNGTexture)
+        {
+          gPNGTexture->draw(snapshot, 0, 0);
+        }
+
+        //Hand it to the render thread
+        gSnapshots.publish();
+      });
+
+      loop.on_render([](Float64)
+      {
+        if (gRenderer.is_valid())
         {
-          //User requests quit
-          if (e.type == SDL_QUIT)
           {
-            quit = true;
+            LSE_PROFILE_ZONE("Draw");
+            gRenderer.begin_frame();
+
+            //Draw the newest snapshot, or the last one again if none arrived
+            gSnapshots.fetch();
+            gRenderer.submit(gSnapshots.read_buffer());
+            gRenderer.flush();
           }
+
+          LSE_PROFILE_ZONE("Present");
+
+          //Present the batched draws
+          gRenderer.present();
         }
+        else if (!gDirtyRegions.empty())
+        {
+          {
+            LSE_PROFILE_ZONE("Blit");
 
-        //Apply the PNG image
-        SDL_BlitSurface(gPNGSurface, NULL, gScreenSurface, NULL);
+            //Apply the PNG image to the regions that changed
+            for (SDL_Rect region : gDirtyRegions.regions())
+            {
+              SDL_BlitSurface(gPNGSurface, &region, gScreenSurface, &region);
+            }
+          }
 
-        //Update the surface
-        SDL_UpdateWindowSurface(gWindow);
-      }
+          LSE_PROFILE_ZONE("Present");
+
+          //Update only the changed parts of the surface
+          gDirtyRegions.present(gWindow);
+        }
+
+        //Throw away this frame's scratch memory
+        gFrameArena.reset();
+        lse::memory::end_frame();
+        LSE_PROFILE_COUNTER("Frame Arena", gFrameArena.last_frame_peak());
+
+        //Sample engine counters for the telemetry file
+        sampleTelemetry();
+      });
+
+      //While application is running
+      loop.run_threaded();
     }
   }
 
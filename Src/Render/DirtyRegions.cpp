@@ -0,0 +1,126 @@
+/******************************************************************************
+File: DirtyRegions.cpp
+Created: 10/17/2026 1:26:10 PM
+Copyright (c) 2017 Turn Tactics
+
+Permission is hereby granted, free of charge, to any person obtaining a copy
+of this software and associated documentation files (the "Software"), to deal
+in the Software without restriction, including without limitation the rights
+to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+copies of the Software, and to permit persons to whom the Software is
+furnished to do so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in
+all copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+SOFTWARE.
+
+Purpose: Tracks the regions of the window surface that changed during a frame so
+         the software path only redraws and presents those regions.
+
+Author: James Womack
+
+********************************************************************************/
+#include "DirtyRegions.h"
+
+namespace lse
+{
+	namespace
+	{
+		inline Sint64 area(const SDL_Rect& rect)
+		{
+			return static_cast<Sint64>(rect.w) * rect.h;
+		}
+	}
+
+	DirtyRegions::DirtyRegions(Int32 width, Int32 height, UInt32 maxRegions, Int32 mergeSlack) :
+		m_bounds{ 0, 0, width, height }, m_maxRegions(std::max<UInt32>(maxRegions, 1)),
+		m_mergeSlack(mergeSlack)
+	{
+	}
+
+	void DirtyRegions::resize(Int32 width, Int32 height)
+	{
+		m_bounds = SDL_Rect{ 0, 0, width, height };
+		invalidate_all();
+	}
+
+	void DirtyRegions::add(const SDL_Rect& rect)
+	{
+		SDL_Rect clipped;
+		if (!SDL_IntersectRect(&rect, &m_bounds, &clipped))
+		{
+			return;
+		}
+
+		merge(clipped);
+
+		if (m_regions.size() > m_maxRegions)
+		{
+			// Too many scattered regions, one big copy is cheaper than many small
+			SDL_Rect bounds = m_regions.front();
+			for (const SDL_Rect& region : m_regions)
+			{
+				SDL_UnionRect(&bounds, &region, &bounds);
+			}
+
+			m_regions.clear();
+			m_regions.push_back(bounds);
+		}
+	}
+
+	void DirtyRegions::invalidate_all()
+	{
+		m_regions.clear();
+
+		if (!SDL_RectEmpty(&m_bounds))
+		{
+			m_regions.push_back(m_bounds);
+		}
+	}
+
+	bool DirtyRegions::present(SDL_Window* window)
+	{
+		if (m_regions.empty())
+		{
+			return true;
+		}
+
+		const bool success = SDL_UpdateWindowSurfaceRects(window, m_regions.data(),
+			static_cast<int>(m_regions.size())) == 0;
+		m_regions.clear();
+		return success;
+	}
+
+	void DirtyRegions::merge(SDL_Rect rect)
+	{
+		bool merged = true;
+		while (merged)
+		{
+			merged = false;
+
+			for (auto it = m_regions.begin(); it != m_regions.end(); ++it)
+			{
+				SDL_Rect combined;
+				SDL_UnionRect(&rect, &*it, &combined);
+
+				// Merge when the bounding box costs little more than copying both
+				if (area(combined) <= area(rect) + area(*it) + m_mergeSlack)
+				{
+					rect = combined;
+					m_regions.erase(it);
+					merged = true;
+					break;
+				}
+			}
+		}
+
+		m_regions.push_back(rect);
+	}
+}
@@ -0,0 +1,85 @@
+/******************************************************************************
+File: DirtyRegions.h
+Created: 10/17/2026 1:26:10 PM
+Copyright (c) 2017 Turn Tactics
+
+Permission is hereby granted, free of charge, to any person obtaining a copy
+of this software and associated documentation files (the "Software"), to deal
+in the Software without restriction, including without limitation the rights
+to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+copies of the Software, and to permit persons to whom the Software is
+furnished to do so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in
+all copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+SOFTWARE.
+
+Purpose: Tracks the regions of the window surface that changed during a frame so
+         the software path only redraws and presents those regions.
+
+Author: James Womack
+
+********************************************************************************/
+#pragma once
+
+#include "../Common.h"
+#include "../Containers/SmallVector.h"
+
+#include <SDL.h>
+
+namespace lse
+{
+	// Collects the rectangles that changed this frame and merges them into a
+	// small set of regions. Rectangles are merged when their bounding box
+	// wastes no more than the merge slack, when there are more regions than
+	// the limit they are all collapsed into one bounding box.
+	class DirtyRegions
+	{
+	public:
+		// Holds the default limit plus the region being added inline, so
+		// tracking regions never allocates unless the limit is raised
+		using RegionList = containers::SmallVector<SDL_Rect, 17>;
+
+		explicit DirtyRegions(Int32 width = 0, Int32 height = 0, UInt32 maxRegions = 16,
+			Int32 mergeSlack = 32 * 32);
+
+		// Sets the bounds regions are clipped to and marks all of it dirty
+		void resize(Int32 width, Int32 height);
+
+		// Marks a rectangle as changed, it is clipped to the bounds
+		void add(const SDL_Rect& rect);
+
+		// Marks the whole of the bounds as changed
+		void invalidate_all();
+
+		// Forgets all regions without presenting them
+		void clear() { m_regions.clear(); }
+
+		// Returns if nothing has changed since the last present
+		bool empty() const { return m_regions.empty(); }
+
+		// The merged dirty regions, redraw these before presenting
+		const RegionList& regions() const { return m_regions; }
+
+		// Copies the dirty regions of the window surface to the screen and
+		// clears them, returns false if SDL failed to update the window
+		bool present(SDL_Window* window);
+
+	private:
+		// Merges rect into any region it is cheap to combine with, repeating
+		// while the grown region can absorb others
+		void merge(SDL_Rect rect);
+
+		RegionList m_regions;
+		SDL_Rect m_bounds;
+		UInt32 m_maxRegions;
+		Int32 m_mergeSlack;
+	};
+}
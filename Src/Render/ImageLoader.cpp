@@ -0,0 +1,104 @@
+/******************************************************************************
+File: ImageLoader.cpp
+Created: 10/18/2026 1:37:09 PM
+Copyright (c) 2017 Turn Tactics
+
+Permission is hereby granted, free of charge, to any person obtaining a copy
+of this software and associated documentation files (the "Software"), to deal
+in the Software without restriction, including without limitation the rights
+to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+copies of the Software, and to permit persons to whom the Software is
+furnished to do so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in
+all copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+SOFTWARE.
+
+Purpose: Contains the asynchronous image loader that decodes and converts images
+         on the job system so only the texture upload is left for the render
+         thread.
+
+Author: James Womack
+
+********************************************************************************/
+#include "ImageLoader.h"
+#include "../Util/Logger.h"
+
+#include <SDL_image.h>
+
+namespace lse
+{
+	ImageRequest::State::~State()
+	{
+		if (surface != nullptr)
+		{
+			SDL_FreeSurface(surface);
+		}
+	}
+
+	void ImageRequest::wait(JobSystem& jobs) const
+	{
+		if (m_state != nullptr)
+		{
+			jobs.wait(m_state->counter);
+		}
+	}
+
+	SDL_Surface* ImageRequest::take_surface()
+	{
+		if (!is_ready())
+		{
+			return nullptr;
+		}
+
+		SDL_Surface* surface = m_state->surface;
+		m_state->surface = nullptr;
+		return surface;
+	}
+
+	const String& ImageRequest::path() const
+	{
+		static const String s_empty;
+		return m_state != nullptr ? m_state->path : s_empty;
+	}
+
+	ImageRequest load_image_async(JobSystem& jobs, String path, Uint32 pixelFormat)
+	{
+		ImageRequest request;
+		request.m_state = std::make_shared<ImageRequest::State>();
+		request.m_state->path = std::move(path);
+
+		// The job holds its own reference so the request may be dropped early
+		std::shared_ptr<ImageRequest::State> state = request.m_state;
+		jobs.submit([state, pixelFormat]()
+		{
+			SDL_Surface* loadedSurface = IMG_Load(state->path.c_str());
+			if (loadedSurface == nullptr)
+			{
+				LSE_LOG_ERROR(Render, "Unable to load image %s! SDL_image Error: %s", state->path, IMG_GetError());
+			}
+			else
+			{
+				// Convert here so the render thread only has to upload
+				state->surface = SDL_ConvertSurfaceFormat(loadedSurface, pixelFormat, 0);
+				if (state->surface == nullptr)
+				{
+					LSE_LOG_ERROR(Render, "Unable to convert image %s! SDL Error: %s", state->path, SDL_GetError());
+				}
+
+				SDL_FreeSurface(loadedSurface);
+			}
+
+			state->ready.store(true, std::memory_order_release);
+		}, &request.m_state->counter);
+
+		return request;
+	}
+}
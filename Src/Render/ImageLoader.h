@@ -0,0 +1,90 @@
+/******************************************************************************
+File: ImageLoader.h
+Created: 10/18/2026 1:37:09 PM
+Copyright (c) 2017 Turn Tactics
+
+Permission is hereby granted, free of charge, to any person obtaining a copy
+of this software and associated documentation files (the "Software"), to deal
+in the Software without restriction, including without limitation the rights
+to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+copies of the Software, and to permit persons to whom the Software is
+furnished to do so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in
+all copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+SOFTWARE.
+
+Purpose: Contains the asynchronous image loader that decodes and converts images
+         on the job system so only the texture upload is left for the render
+         thread.
+
+Author: James Womack
+
+********************************************************************************/
+#pragma once
+
+#include "../Common.h"
+#include "../Util/JobSystem.h"
+
+#include <SDL.h>
+#include <atomic>
+#include <memory>
+
+namespace lse
+{
+	// Handle to an image being decoded on a worker thread. Copies share the
+	// same request, the decoded surface belongs to whoever takes it.
+	class ImageRequest
+	{
+	public:
+		ImageRequest() = default;
+
+		// Returns if the handle refers to a request
+		bool is_valid() const { return m_state != nullptr; }
+
+		// Returns if decoding has finished, successfully or not
+		bool is_ready() const { return m_state != nullptr && m_state->ready.load(std::memory_order_acquire); }
+
+		// Returns if decoding finished without producing a surface
+		bool failed() const { return is_ready() && m_state->surface == nullptr; }
+
+		// Runs jobs on the calling thread until the image is decoded
+		void wait(JobSystem& jobs) const;
+
+		// Takes ownership of the decoded surface, null if decoding failed,
+		// is not finished or the surface was already taken
+		SDL_Surface* take_surface();
+
+		// The path the image is loaded from
+		const String& path() const;
+
+	private:
+		friend ImageRequest load_image_async(JobSystem& jobs, String path, Uint32 pixelFormat);
+
+		struct State
+		{
+			State() : ready(false), surface(nullptr) {}
+			~State();
+
+			String path;
+			std::atomic<bool> ready;
+			SDL_Surface* surface;
+			JobCounter counter;
+		};
+
+		std::shared_ptr<State> m_state;
+	};
+
+	// Starts loading an image on the job system and converting it to the given
+	// pixel format. IMG_Init must already have been called for the formats
+	// being loaded since SDL_image initializes them lazily otherwise, which is
+	// not thread safe.
+	ImageRequest load_image_async(JobSystem& jobs, String path, Uint32 pixelFormat = SDL_PIXELFORMAT_ARGB8888);
+}
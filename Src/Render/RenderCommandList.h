@@ -0,0 +1,102 @@
+/******************************************************************************
+File: RenderCommandList.h
+Created: 10/17/2026 3:40:22 PM
+Copyright (c) 2017 Turn Tactics
+
+Permission is hereby granted, free of charge, to any person obtaining a copy
+of this software and associated documentation files (the "Software"), to deal
+in the Software without restriction, including without limitation the rights
+to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+copies of the Software, and to permit persons to whom the Software is
+furnished to do so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in
+all copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+SOFTWARE.
+
+Purpose: Contains the list of draw commands that make up a frame, built by the
+         simulation and handed to the renderer to submit.
+
+Author: James Womack
+
+********************************************************************************/
+#pragma once
+
+#include "../Common.h"
+
+#include <SDL.h>
+
+namespace lse
+{
+	// A single textured quad queued for drawing
+	struct DrawCommand
+	{
+		SDL_Texture* texture;
+		SDL_Rect source;
+		SDL_Rect destination;
+		SDL_Color tint;
+		Int32 layer;
+	};
+
+	// An ordered list of draw commands. It only holds texture pointers and
+	// rectangles so it can be built on any thread and handed to the renderer.
+	class RenderCommandList
+	{
+	public:
+		// Queues a texture to be drawn, a null source draws the whole texture.
+		// Passing null queries the texture size from SDL so off the render
+		// thread callers should pass the source rect they already know.
+		void draw(SDL_Texture* texture, const SDL_Rect* source, const SDL_Rect& destination,
+			Int32 layer = 0, SDL_Color tint = SDL_Color{ 255, 255, 255, 255 })
+		{
+			if (texture == nullptr)
+			{
+				return;
+			}
+
+			DrawCommand command;
+			command.texture = texture;
+			command.destination = destination;
+			command.tint = tint;
+			command.layer = layer;
+
+			if (source != nullptr)
+			{
+				command.source = *source;
+			}
+			else
+			{
+				command.source.x = 0;
+				command.source.y = 0;
+				SDL_QueryTexture(texture, nullptr, nullptr, &command.source.w, &command.source.h);
+			}
+
+			m_commands.push_back(command);
+		}
+
+		// Adds every command of another list after the ones already queued
+		void append(const RenderCommandList& other)
+		{
+			m_commands.insert(m_commands.end(), other.m_commands.begin(), other.m_commands.end());
+		}
+
+		// Empties the list but keeps its memory for the next frame
+		void clear() { m_commands.clear(); }
+
+		bool empty() const { return m_commands.empty(); }
+		size_t size() const { return m_commands.size(); }
+
+		containers::Vector<DrawCommand>& commands() { return m_commands; }
+		const containers::Vector<DrawCommand>& commands() const { return m_commands; }
+
+	private:
+		containers::Vector<DrawCommand> m_commands;
+	};
+}
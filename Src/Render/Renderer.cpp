@@ -0,0 +1,233 @@
+/******************************************************************************
+File: Renderer.cpp
+Created: 10/17/2026 11:02:41 AM
+Copyright (c) 2017 Turn Tactics
+
+Permission is hereby granted, free of charge, to any person obtaining a copy
+of this software and associated documentation files (the "Software"), to deal
+in the Software without restriction, including without limitation the rights
+to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+copies of the Software, and to permit persons to whom the Software is
+furnished to do so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in
+all copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+SOFTWARE.
+
+Purpose: Contains the renderer that owns the SDL_Renderer, queues draw commands
+         for a frame and flushes them in batches with as few texture
+         switches as possible.
+
+Author: James Womack
+
+********************************************************************************/
+#include "Renderer.h"
+
+#include <algorithm>
+#include <functional>
+#include <numeric>
+
+namespace lse
+{
+	Renderer::Renderer() :
+		m_renderer(nullptr), m_frameArena(nullptr)
+	{
+	}
+
+	Renderer::~Renderer()
+	{
+		shutdown();
+	}
+
+	bool Renderer::init(SDL_Window* window, Uint32 flags)
+	{
+		shutdown();
+
+		m_renderer = SDL_CreateRenderer(window, -1, flags);
+		if (m_renderer == nullptr)
+		{
+			return false;
+		}
+
+		SDL_SetRenderDrawBlendMode(m_renderer, SDL_BLENDMODE_BLEND);
+		return true;
+	}
+
+	void Renderer::shutdown()
+	{
+		m_commands.clear();
+
+		if (m_renderer != nullptr)
+		{
+			SDL_DestroyRenderer(m_renderer);
+			m_renderer = nullptr;
+		}
+	}
+
+	void Renderer::begin_frame(SDL_Color clearColor)
+	{
+		m_commands.clear();
+		m_stats = RenderStats();
+
+		SDL_SetRenderDrawColor(m_renderer, clearColor.r, clearColor.g, clearColor.b, clearColor.a);
+		SDL_RenderClear(m_renderer);
+	}
+
+	void Renderer::flush()
+	{
+		containers::Vector<DrawCommand>& commands = m_commands.commands();
+		if (commands.empty())
+		{
+			return;
+		}
+
+		// Layers keep their order, inside a layer quads are grouped by texture
+		const auto less = [](const DrawCommand& a, const DrawCommand& b)
+		{
+			if (a.layer != b.layer)
+			{
+				return a.layer < b.layer;
+			}
+
+			return std::less<SDL_Texture*>()(a.texture, b.texture);
+		};
+
+		const size_t count = commands.size();
+		const DrawCommand* first = commands.data();
+		if (m_frameArena != nullptr)
+		{
+			// Sort positions in the frame arena and gather the commands there,
+			// breaking ties by position keeps the sort stable without the heap
+			// buffer std::stable_sort takes
+			UInt32* order = static_cast<UInt32*>(m_frameArena->allocate(count * sizeof(UInt32), alignof(UInt32)));
+			std::iota(order, order + count, 0u);
+			std::sort(order, order + count, [&commands, &less](UInt32 a, UInt32 b)
+			{
+				if (less(commands[a], commands[b]))
+				{
+					return true;
+				}
+
+				return !less(commands[b], commands[a]) && a < b;
+			});
+
+			DrawCommand* sorted = static_cast<DrawCommand*>(m_frameArena->allocate(count * sizeof(DrawCommand), alignof(DrawCommand)));
+			for (size_t i = 0; i < count; ++i)
+			{
+				sorted[i] = commands[order[i]];
+			}
+			first = sorted;
+		}
+		else
+		{
+			std::stable_sort(commands.begin(), commands.end(), less);
+		}
+
+		const DrawCommand* end = first + count;
+		while (first != end)
+		{
+			const DrawCommand* last = first + 1;
+			while (last != end && last->texture == first->texture)
+			{
+				++last;
+			}
+
+			submit_batch(first, last);
+			++m_stats.textureSwitches;
+			first = last;
+		}
+
+		m_stats.commands += static_cast<UInt32>(count);
+		commands.clear();
+	}
+
+	void Renderer::present()
+	{
+		flush();
+		SDL_RenderPresent(m_renderer);
+	}
+
+#if SDL_VERSION_ATLEAST(2, 0, 18)
+	void Renderer::submit_batch(const DrawCommand* first, const DrawCommand* last)
+	{
+		// One geometry call draws every quad in the batch
+		Int32 width = 0;
+		Int32 height = 0;
+		SDL_QueryTexture(first->texture, nullptr, nullptr, &width, &height);
+		const Float32 invWidth = width > 0 ? 1.0f / width : 0.0f;
+		const Float32 invHeight = height > 0 ? 1.0f / height : 0.0f;
+
+		m_vertices.clear();
+		m_indices.clear();
+
+		for (const DrawCommand* command = first; command != last; ++command)
+		{
+			const SDL_Rect& src = command->source;
+			const SDL_Rect& dst = command->destination;
+
+			const Float32 u0 = src.x * invWidth;
+			const Float32 v0 = src.y * invHeight;
+			const Float32 u1 = (src.x + src.w) * invWidth;
+			const Float32 v1 = (src.y + src.h) * invHeight;
+
+			const Float32 x0 = static_cast<Float32>(dst.x);
+			const Float32 y0 = static_cast<Float32>(dst.y);
+			const Float32 x1 = static_cast<Float32>(dst.x + dst.w);
+			const Float32 y1 = static_cast<Float32>(dst.y + dst.h);
+
+			const int base = static_cast<int>(m_vertices.size());
+			m_vertices.push_back(SDL_Vertex{ { x0, y0 }, command->tint, { u0, v0 } });
+			m_vertices.push_back(SDL_Vertex{ { x1, y0 }, command->tint, { u1, v0 } });
+			m_vertices.push_back(SDL_Vertex{ { x1, y1 }, command->tint, { u1, v1 } });
+			m_vertices.push_back(SDL_Vertex{ { x0, y1 }, command->tint, { u0, v1 } });
+
+			m_indices.push_back(base);
+			m_indices.push_back(base + 1);
+			m_indices.push_back(base + 2);
+			m_indices.push_back(base);
+			m_indices.push_back(base + 2);
+			m_indices.push_back(base + 3);
+		}
+
+		SDL_RenderGeometry(m_renderer, first->texture,
+			m_vertices.data(), static_cast<int>(m_vertices.size()),
+			m_indices.data(), static_cast<int>(m_indices.size()));
+		++m_stats.drawCalls;
+	}
+#else
+	void Renderer::submit_batch(const DrawCommand* first, const DrawCommand* last)
+	{
+		// Without SDL_RenderGeometry each quad is its own copy, the texture
+		// stays bound for the whole batch so the driver can still merge them
+		SDL_Color current{ 255, 255, 255, 255 };
+
+		for (const DrawCommand* command = first; command != last; ++command)
+		{
+			const SDL_Color& tint = command->tint;
+			if (tint.r != current.r || tint.g != current.g || tint.b != current.b || tint.a != current.a)
+			{
+				SDL_SetTextureColorMod(command->texture, tint.r, tint.g, tint.b);
+				SDL_SetTextureAlphaMod(command->texture, tint.a);
+				current = tint;
+			}
+
+			SDL_RenderCopy(m_renderer, command->texture, &command->source, &command->destination);
+			++m_stats.drawCalls;
+		}
+
+		// Leave the texture untinted for anyone else using it
+		if (current.r != 255 || current.g != 255 || current.b != 255 || current.a != 255)
+		{
+			SDL_SetTextureColorMod(first->texture, 255, 255, 255);
+			SDL_SetTextureAlphaMod(first->texture, 255);
+		}
+	}
+#endif
+}
@@ -0,0 +1,112 @@
+/******************************************************************************
+File: Renderer.h
+Created: 10/17/2026 11:02:41 AM
+Copyright (c) 2017 Turn Tactics
+
+Permission is hereby granted, free of charge, to any person obtaining a copy
+of this software and associated documentation files (the "Software"), to deal
+in the Software without restriction, including without limitation the rights
+to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+copies of the Software, and to permit persons to whom the Software is
+furnished to do so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in
+all copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+SOFTWARE.
+
+Purpose: Contains the renderer that owns the SDL_Renderer, queues draw commands
+         for a frame and flushes them in batches with as few texture
+         switches as possible.
+
+Author: James Womack
+
+********************************************************************************/
+#pragma once
+
+#include "../Common.h"
+#include "../Util/FrameArena.h"
+#include "RenderCommandList.h"
+
+#include <SDL.h>
+
+namespace lse
+{
+	// Counters for the last flushed frame
+	struct RenderStats
+	{
+		UInt32 commands = 0;
+		UInt32 drawCalls = 0;
+		UInt32 textureSwitches = 0;
+	};
+
+	// Owns the SDL_Renderer for a window and batches the draw calls made
+	// during a frame. Commands are sorted by layer and then by texture so
+	// quads sharing a texture are submitted together, the order of quads on
+	// the same layer that use different textures is not kept.
+	class Renderer
+	{
+	public:
+		Renderer();
+		~Renderer();
+
+		Renderer(const Renderer&) = delete;
+		Renderer& operator=(const Renderer&) = delete;
+
+		// Creates the SDL_Renderer for the window, returns false if SDL could
+		// not create a renderer with the given flags
+		bool init(SDL_Window* window, Uint32 flags = SDL_RENDERER_ACCELERATED);
+
+		// Destroys the SDL_Renderer and drops any queued commands
+		void shutdown();
+
+		// Returns if the renderer was created and can be drawn to
+		bool is_valid() const { return m_renderer != nullptr; }
+
+		// The underlying SDL_Renderer used to create textures
+		SDL_Renderer* sdl_renderer() const { return m_renderer; }
+
+		// Arena flush sorts the frame's commands in, reset by its owner after
+		// the frame is presented. Without one they are sorted on the heap.
+		void set_frame_arena(LinearArena* arena) { m_frameArena = arena; }
+
+		// Clears the back buffer and starts a new command list
+		void begin_frame(SDL_Color clearColor = SDL_Color{ 0, 0, 0, 255 });
+
+		// The command list for the current frame, draws queued here are
+		// submitted on the next flush
+		RenderCommandList& commands() { return m_commands; }
+
+		// Queues every command of a list built elsewhere, such as a snapshot
+		// published by the simulation thread
+		void submit(const RenderCommandList& list) { m_commands.append(list); }
+
+		// Submits every queued command to SDL and empties the command list
+		void flush();
+
+		// Flushes the command list and presents the back buffer
+		void present();
+
+		// Counters for the last flushed frame
+		const RenderStats& stats() const { return m_stats; }
+
+	private:
+		// Submits commands [first, last) which all share one texture
+		void submit_batch(const DrawCommand* first, const DrawCommand* last);
+
+		SDL_Renderer* m_renderer;
+		LinearArena* m_frameArena;
+		RenderCommandList m_commands;
+#if SDL_VERSION_ATLEAST(2, 0, 18)
+		containers::Vector<SDL_Vertex> m_vertices;
+		containers::Vector<int> m_indices;
+#endif
+		RenderStats m_stats;
+	};
+}
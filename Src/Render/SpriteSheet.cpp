@@ -1,4 +1,35 @@
 #include "SpriteSheet.h"
 
-SpriteSheet::SpriteSheet(std::string path) {
+SpriteSheet::SpriteSheet(lse::Renderer& renderer, const std::string& path, Int32 frameWidth, Int32 frameHeight) {
+	if (!texture.load_from_file(renderer, path) || frameWidth <= 0 || frameHeight <= 0) {
+		return;
+	}
+
+	const Int32 columns = texture.width() / frameWidth;
+	const Int32 rows = texture.height() / frameHeight;
+	for (Int32 row = 0; row < rows; ++row) {
+		for (Int32 column = 0; column < columns; ++column) {
+			frames.push_back(Frame{ &texture, SDL_Rect{ column * frameWidth, row * frameHeight, frameWidth, frameHeight } });
+		}
+	}
+}
+
+SpriteSheet::SpriteSheet(const lse::TextureAtlas& atlas, const lse::containers::Vector<UInt32>& frameIds) {
+	for (UInt32 id : frameIds) {
+		if (id >= atlas.frame_count()) {
+			continue;
+		}
+
+		const lse::AtlasFrame& frame = atlas.frame(id);
+		frames.push_back(Frame{ &atlas.page(frame.page), frame.rect });
+	}
+}
+
+void SpriteSheet::draw_frame(lse::RenderCommandList& commands, Int32 frame, Int32 x, Int32 y, Int32 layer) const {
+	if (frame < 0 || frame >= frame_count()) {
+		return;
+	}
+
+	const Frame& source = frames[frame];
+	source.texture->draw(commands, x, y, &source.rect, layer);
 }
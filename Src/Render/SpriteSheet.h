@@ -32,14 +32,39 @@ Author: James Womack
 #include <SDL_image.h>
 #include <string>
 #include "Texture.h"
+#include "TextureAtlas.h"
 #include "../Common.h"
 
 
+// A list of frames drawn from textures. A sheet is either a single texture
+// split into a grid of equally sized frames, numbered left to right and then
+// top to bottom, or a set of frames looked up in a texture atlas.
 class SpriteSheet {
 private:
-	Texture * texture;
+	// Where a frame is drawn from
+	struct Frame {
+		const GameTexture* texture;
+		SDL_Rect rect;
+	};
+
+	// Only holds a texture when the sheet was loaded from a grid image
+	GameTexture texture;
+	lse::containers::Vector<Frame> frames;
 
 public:
-	SpriteSheet(std::string path);
+	SpriteSheet(lse::Renderer& renderer, const std::string& path, Int32 frameWidth, Int32 frameHeight);
+
+	// Builds a sheet from frames of an atlas, which must outlive the sheet.
+	// Frame IDs that are not in the atlas are skipped.
+	SpriteSheet(const lse::TextureAtlas& atlas, const lse::containers::Vector<UInt32>& frameIds);
+
+	// Returns if the sheet has any frames to draw
+	bool is_loaded() const { return !frames.empty(); }
+
+	// Number of frames in the sheet
+	Int32 frame_count() const { return static_cast<Int32>(frames.size()); }
+
+	// Queues a frame in the command list to be drawn with its upper-left corner at x, y
+	void draw_frame(lse::RenderCommandList& commands, Int32 frame, Int32 x, Int32 y, Int32 layer = 0) const;
 
 };
@@ -1,11 +1,64 @@
-#include "Texture.h"
-
-GameTexture::GameTexture() {
-}
-
-GameTexture::~GameTexture() {
-}
-
-bool GameTexture::load_from_file() {
-	return false;
-}
+#include "Texture.h"
+#include "../Util/Logger.h"
+
+GameTexture::GameTexture() :
+	texture(nullptr), textureWidth(0), textureHeight(0) {
+}
+
+GameTexture::~GameTexture() {
+	free();
+}
+
+bool GameTexture::load_from_file(lse::Renderer& renderer, const std::string& path) {
+	free();
+
+	texture = IMG_LoadTexture(renderer.sdl_renderer(), path.c_str());
+	if (texture == nullptr) {
+		LSE_LOG_ERROR(Render, "Unable to load texture %s! SDL_image Error: %s", path, IMG_GetError());
+		return false;
+	}
+
+	SDL_QueryTexture(texture, nullptr, nullptr, &textureWidth, &textureHeight);
+	return true;
+}
+
+bool GameTexture::load_from_surface(lse::Renderer& renderer, SDL_Surface* surface) {
+	free();
+
+	texture = SDL_CreateTextureFromSurface(renderer.sdl_renderer(), surface);
+	if (texture == nullptr) {
+		LSE_LOG_ERROR(Render, "Unable to create texture! SDL Error: %s", SDL_GetError());
+		return false;
+	}
+
+	textureWidth = surface->w;
+	textureHeight = surface->h;
+	return true;
+}
+
+bool GameTexture::load_from_image(lse::Renderer& renderer, lse::ImageRequest& request) {
+	SDL_Surface* surface = request.take_surface();
+	if (surface == nullptr) {
+		return false;
+	}
+
+	const bool success = load_from_surface(renderer, surface);
+	SDL_FreeSurface(surface);
+	return success;
+}
+
+void GameTexture::free() {
+	if (texture != nullptr) {
+		SDL_DestroyTexture(texture);
+		texture = nullptr;
+		textureWidth = 0;
+		textureHeight = 0;
+	}
+}
+
+void GameTexture::draw(lse::RenderCommandList& commands, Int32 x, Int32 y, const SDL_Rect* clip, Int32 layer) const {
+	const SDL_Rect source = clip != nullptr ? *clip : SDL_Rect{ 0, 0, textureWidth, textureHeight };
+	const SDL_Rect destination{ x, y, source.w, source.h };
+
+	commands.draw(texture, &source, destination, layer);
+}
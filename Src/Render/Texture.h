@@ -29,6 +29,8 @@ Author: James Womack
 #pragma once
 
 #include "../Common.h"
+#include "ImageLoader.h"
+#include "Renderer.h"
 
 #include <SDL.h>
 #include <SDL_image.h>
@@ -37,7 +39,39 @@ class GameTexture {
 public:
 	GameTexture();
 	~GameTexture();
-	bool load_from_file();
+
+	GameTexture(const GameTexture&) = delete;
+	GameTexture& operator=(const GameTexture&) = delete;
+
+	// Loads an image from disk into a texture created by the renderer,
+	// any texture already held is freed first
+	bool load_from_file(lse::Renderer& renderer, const std::string& path);
+
+	// Uploads a surface into a new texture, the surface is left untouched
+	bool load_from_surface(lse::Renderer& renderer, SDL_Surface* surface);
+
+	// Uploads an image decoded by lse::load_image_async, must be called on
+	// the render thread once the request is ready. Returns false if the
+	// request is not ready or failed to decode.
+	bool load_from_image(lse::Renderer& renderer, lse::ImageRequest& request);
+
+	// Destroys the texture if one is loaded
+	void free();
+
+	// Queues the texture in the command list to be drawn with its upper-left corner at x, y. The
+	// clip selects part of the texture to draw, null draws all of it
+	void draw(lse::RenderCommandList& commands, Int32 x, Int32 y, const SDL_Rect* clip = nullptr, Int32 layer = 0) const;
+
+	// Returns if a texture is loaded
+	bool is_loaded() const { return texture != nullptr; }
+
+	Int32 width() const { return textureWidth; }
+	Int32 height() const { return textureHeight; }
+
+	SDL_Texture* sdl_texture() const { return texture; }
+
 private:
 	SDL_Texture* texture;
+	Int32 textureWidth;
+	Int32 textureHeight;
 };
\ No newline at end of file
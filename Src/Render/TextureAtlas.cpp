@@ -0,0 +1,449 @@
+/******************************************************************************
+File: TextureAtlas.cpp
+Created: 10/18/2026 3:21:44 PM
+Copyright (c) 2017 Turn Tactics
+
+Permission is hereby granted, free of charge, to any person obtaining a copy
+of this software and associated documentation files (the "Software"), to deal
+in the Software without restriction, including without limitation the rights
+to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+copies of the Software, and to permit persons to whom the Software is
+furnished to do so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in
+all copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+SOFTWARE.
+
+Purpose: Contains the texture atlas builder that packs many images into a few
+         large pages and the atlas that resolves frame IDs to a page and a
+         rectangle at runtime.
+
+Author: James Womack
+
+********************************************************************************/
+#include "TextureAtlas.h"
+#include "../Util/Logger.h"
+
+#include <SDL_image.h>
+#include <climits>
+#include <fstream>
+#include <numeric>
+#include <sstream>
+
+namespace lse
+{
+	namespace
+	{
+		// Directory part of a path including the trailing separator
+		String directory_of(const String& path)
+		{
+			const size_t separator = path.find_last_of("/\\");
+			return separator == String::npos ? String() : path.substr(0, separator + 1);
+		}
+
+		// A path with its extension removed
+		String strip_extension(const String& path)
+		{
+			const size_t dot = path.find_last_of('.');
+			const size_t separator = path.find_last_of("/\\");
+			if (dot == String::npos || (separator != String::npos && dot < separator))
+			{
+				return path;
+			}
+
+			return path.substr(0, dot);
+		}
+	}
+
+	SkylinePacker::SkylinePacker(Int32 width, Int32 height) :
+		m_width(width), m_height(height)
+	{
+		m_skyline.push_back(Segment{ 0, 0, width });
+	}
+
+	bool SkylinePacker::insert(Int32 width, Int32 height, SDL_Point& position)
+	{
+		size_t bestIndex = m_skyline.size();
+		Int32 bestTop = INT_MAX;
+		Int32 bestWidth = INT_MAX;
+
+		for (size_t i = 0; i < m_skyline.size(); ++i)
+		{
+			const Int32 y = fit(i, width, height);
+			if (y < 0)
+			{
+				continue;
+			}
+
+			// Lowest top edge wins, then the narrowest segment to keep wide
+			// gaps for wide images
+			const Int32 top = y + height;
+			if (top < bestTop || (top == bestTop && m_skyline[i].width < bestWidth))
+			{
+				bestIndex = i;
+				bestTop = top;
+				bestWidth = m_skyline[i].width;
+			}
+		}
+
+		if (bestIndex == m_skyline.size())
+		{
+			return false;
+		}
+
+		position.x = m_skyline[bestIndex].x;
+		position.y = bestTop - height;
+
+		m_skyline.insert(m_skyline.begin() + bestIndex, Segment{ position.x, bestTop, width });
+
+		// Cut back the segments now covered by the new one
+		for (size_t i = bestIndex + 1; i < m_skyline.size();)
+		{
+			const Segment& previous = m_skyline[i - 1];
+			const Int32 previousEnd = previous.x + previous.width;
+			if (m_skyline[i].x >= previousEnd)
+			{
+				break;
+			}
+
+			const Int32 shrink = previousEnd - m_skyline[i].x;
+			m_skyline[i].x += shrink;
+			m_skyline[i].width -= shrink;
+
+			if (m_skyline[i].width > 0)
+			{
+				break;
+			}
+
+			m_skyline.erase(m_skyline.begin() + i);
+		}
+
+		// Join neighbours at the same height
+		for (size_t i = 0; i + 1 < m_skyline.size();)
+		{
+			if (m_skyline[i].y == m_skyline[i + 1].y)
+			{
+				m_skyline[i].width += m_skyline[i + 1].width;
+				m_skyline.erase(m_skyline.begin() + i + 1);
+			}
+			else
+			{
+				++i;
+			}
+		}
+
+		return true;
+	}
+
+	Int32 SkylinePacker::fit(size_t index, Int32 width, Int32 height) const
+	{
+		if (m_skyline[index].x + width > m_width)
+		{
+			return -1;
+		}
+
+		Int32 y = 0;
+		Int32 remaining = width;
+		for (size_t i = index; remaining > 0; ++i)
+		{
+			if (i == m_skyline.size())
+			{
+				return -1;
+			}
+
+			y = std::max(y, m_skyline[i].y);
+			if (y + height > m_height)
+			{
+				return -1;
+			}
+
+			remaining -= m_skyline[i].width;
+		}
+
+		return y;
+	}
+
+	AtlasBuilder::AtlasBuilder(Int32 pageWidth, Int32 pageHeight, Int32 padding) :
+		m_pageWidth(pageWidth), m_pageHeight(pageHeight), m_padding(std::max(padding, 0))
+	{
+	}
+
+	AtlasBuilder::~AtlasBuilder()
+	{
+		for (SDL_Surface* image : m_images)
+		{
+			SDL_FreeSurface(image);
+		}
+
+		for (SDL_Surface* page : m_pages)
+		{
+			SDL_FreeSurface(page);
+		}
+	}
+
+	bool AtlasBuilder::add_image(const String& name, SDL_Surface* surface)
+	{
+		if (surface == nullptr)
+		{
+			return false;
+		}
+
+		// Names are written to the frame table separated by spaces
+		const bool badName = name.empty() || name.find_first_of(" \t\r\n") != String::npos
+			|| std::find(m_names.begin(), m_names.end(), name) != m_names.end();
+		const bool tooBig = surface->w + 2 * m_padding > m_pageWidth
+			|| surface->h + 2 * m_padding > m_pageHeight;
+
+		if (badName || tooBig)
+		{
+			LSE_LOG_ERROR(Render, "Unable to add %s to atlas! %s", name, badName ? "Bad or repeated name" : "Image larger than a page");
+			SDL_FreeSurface(surface);
+			return false;
+		}
+
+		m_images.push_back(surface);
+		m_names.push_back(name);
+		return true;
+	}
+
+	bool AtlasBuilder::add_file(const String& name, const String& path)
+	{
+		SDL_Surface* surface = IMG_Load(path.c_str());
+		if (surface == nullptr)
+		{
+			LSE_LOG_ERROR(Render, "Unable to load image %s! SDL_image Error: %s", path, IMG_GetError());
+			return false;
+		}
+
+		return add_image(name, surface);
+	}
+
+	bool AtlasBuilder::build()
+	{
+		for (SDL_Surface* page : m_pages)
+		{
+			SDL_FreeSurface(page);
+		}
+		m_pages.clear();
+		m_frames.assign(m_images.size(), AtlasFrame());
+
+		// Tallest images first packs far tighter with a skyline
+		containers::Vector<size_t> order(m_images.size());
+		std::iota(order.begin(), order.end(), 0);
+		std::stable_sort(order.begin(), order.end(), [this](size_t a, size_t b)
+		{
+			if (m_images[a]->h != m_images[b]->h)
+			{
+				return m_images[a]->h > m_images[b]->h;
+			}
+
+			return m_images[a]->w > m_images[b]->w;
+		});
+
+		// Packing against a page inset by the padding and padding each image
+		// on its right and bottom keeps a gap on every side
+		containers::Vector<SkylinePacker> packers;
+		for (size_t index : order)
+		{
+			const SDL_Surface* image = m_images[index];
+			SDL_Point position{ 0, 0 };
+
+			UInt32 page = 0;
+			while (page < packers.size()
+				&& !packers[page].insert(image->w + m_padding, image->h + m_padding, position))
+			{
+				++page;
+			}
+
+			if (page == packers.size())
+			{
+				packers.push_back(SkylinePacker(m_pageWidth - m_padding, m_pageHeight - m_padding));
+				packers.back().insert(image->w + m_padding, image->h + m_padding, position);
+			}
+
+			m_frames[index] = AtlasFrame{ page, SDL_Rect{ position.x + m_padding, position.y + m_padding, image->w, image->h } };
+		}
+
+		for (size_t i = 0; i < packers.size(); ++i)
+		{
+			SDL_Surface* page = SDL_CreateRGBSurfaceWithFormat(0, m_pageWidth, m_pageHeight, 32, SDL_PIXELFORMAT_ARGB8888);
+			if (page == nullptr)
+			{
+				LSE_LOG_ERROR(Render, "Unable to create atlas page! SDL Error: %s", SDL_GetError());
+				return false;
+			}
+
+			SDL_FillRect(page, nullptr, SDL_MapRGBA(page->format, 0, 0, 0, 0));
+			m_pages.push_back(page);
+		}
+
+		for (size_t i = 0; i < m_images.size(); ++i)
+		{
+			// Copy pixels and alpha as they are instead of blending
+			SDL_SetSurfaceBlendMode(m_images[i], SDL_BLENDMODE_NONE);
+
+			SDL_Rect destination = m_frames[i].rect;
+			SDL_BlitSurface(m_images[i], nullptr, m_pages[m_frames[i].page], &destination);
+		}
+
+		return true;
+	}
+
+	bool AtlasBuilder::save(const String& path) const
+	{
+		std::ofstream table(path, std::ios::out | std::ios::trunc);
+		if (!table)
+		{
+			LSE_LOG_ERROR(Render, "Unable to write atlas %s!", path);
+			return false;
+		}
+
+		const String directory = directory_of(path);
+		const String pageBase = strip_extension(path.substr(directory.size()));
+
+		table << "# Turn Tactics texture atlas\n";
+		for (size_t i = 0; i < m_pages.size(); ++i)
+		{
+			const String pageFile = pageBase + "_" + std::to_string(i) + ".png";
+			if (IMG_SavePNG(m_pages[i], (directory + pageFile).c_str()) != 0)
+			{
+				LSE_LOG_ERROR(Render, "Unable to write atlas page %s! SDL_image Error: %s", pageFile, IMG_GetError());
+				return false;
+			}
+
+			table << "page " << i << " " << pageFile << "\n";
+		}
+
+		for (size_t i = 0; i < m_frames.size(); ++i)
+		{
+			const SDL_Rect& rect = m_frames[i].rect;
+			table << "frame " << m_names[i] << " " << m_frames[i].page << " "
+				<< rect.x << " " << rect.y << " " << rect.w << " " << rect.h << "\n";
+		}
+
+		return !table.fail();
+	}
+
+	bool TextureAtlas::load(Renderer& renderer, const String& path)
+	{
+		clear();
+
+		std::ifstream table(path);
+		if (!table)
+		{
+			LSE_LOG_ERROR(Render, "Unable to open atlas %s!", path);
+			return false;
+		}
+
+		const String directory = directory_of(path);
+
+		String line;
+		while (std::getline(table, line))
+		{
+			std::istringstream fields(line);
+			String kind;
+			fields >> kind;
+
+			if (kind == "page")
+			{
+				UInt32 index = 0;
+				String file;
+				fields >> index >> file;
+
+				std::unique_ptr<GameTexture> page(new GameTexture());
+				if (fields.fail() || index != m_pages.size() || !page->load_from_file(renderer, directory + file))
+				{
+					LSE_LOG_ERROR(Render, "Bad atlas page in %s: %s", path, line);
+					clear();
+					return false;
+				}
+
+				m_pages.push_back(std::move(page));
+			}
+			else if (kind == "frame")
+			{
+				String name;
+				AtlasFrame frame;
+				fields >> name >> frame.page >> frame.rect.x >> frame.rect.y >> frame.rect.w >> frame.rect.h;
+
+				if (fields.fail() || frame.page >= m_pages.size())
+				{
+					LSE_LOG_ERROR(Render, "Bad atlas frame in %s: %s", path, line);
+					clear();
+					return false;
+				}
+
+				if (!m_frameIds.emplace(intern(name), static_cast<UInt32>(m_frames.size())).second)
+				{
+					LSE_LOG_ERROR(Render, "Atlas frame %s in %s repeats a name or has the same id as another frame!", name, path);
+					clear();
+					return false;
+				}
+
+				m_frames.push_back(frame);
+			}
+		}
+
+		return true;
+	}
+
+	bool TextureAtlas::load(Renderer& renderer, const AtlasBuilder& builder)
+	{
+		clear();
+
+		for (SDL_Surface* surface : builder.pages())
+		{
+			std::unique_ptr<GameTexture> page(new GameTexture());
+			if (!page->load_from_surface(renderer, surface))
+			{
+				clear();
+				return false;
+			}
+
+			m_pages.push_back(std::move(page));
+		}
+
+		m_frames = builder.frames();
+		for (size_t i = 0; i < builder.names().size(); ++i)
+		{
+			if (!m_frameIds.emplace(intern(builder.names()[i]), static_cast<UInt32>(i)).second)
+			{
+				LSE_LOG_ERROR(Render, "Atlas frame %s has the same id as another frame!", builder.names()[i]);
+				clear();
+				return false;
+			}
+		}
+
+		return true;
+	}
+
+	void TextureAtlas::clear()
+	{
+		m_pages.clear();
+		m_frames.clear();
+		m_frameIds.clear();
+	}
+
+	UInt32 TextureAtlas::frame_id(const String& name) const
+	{
+		return frame_id(make_string_id(name.data(), name.size()));
+	}
+
+	UInt32 TextureAtlas::frame_id(StringId name) const
+	{
+		const auto it = m_frameIds.find(name);
+		if (it == m_frameIds.end())
+		{
+			return InvalidFrame;
+		}
+
+		return it->second;
+	}
+}
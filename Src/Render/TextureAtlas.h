@@ -0,0 +1,153 @@
+/******************************************************************************
+File: TextureAtlas.h
+Created: 10/18/2026 3:21:44 PM
+Copyright (c) 2017 Turn Tactics
+
+Permission is hereby granted, free of charge, to any person obtaining a copy
+of this software and associated documentation files (the "Software"), to deal
+in the Software without restriction, including without limitation the rights
+to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+copies of the Software, and to permit persons to whom the Software is
+furnished to do so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in
+all copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+SOFTWARE.
+
+Purpose: Contains the texture atlas builder that packs many images into a few
+         large pages and the atlas that resolves frame IDs to a page and a
+         rectangle at runtime.
+
+Author: James Womack
+
+********************************************************************************/
+#pragma once
+
+#include "../Common.h"
+#include "../Util/StringId.h"
+#include "Texture.h"
+
+#include <SDL.h>
+#include <memory>
+
+namespace lse
+{
+	// Where a frame lives inside an atlas
+	struct AtlasFrame
+	{
+		UInt32 page;
+		SDL_Rect rect;
+	};
+
+	// Packs rectangles into a fixed size page with the skyline bottom-left
+	// heuristic, each rectangle goes where its top edge ends up lowest
+	class SkylinePacker
+	{
+	public:
+		SkylinePacker(Int32 width, Int32 height);
+
+		// Finds room for a width by height rectangle, returns false if the
+		// page is too full
+		bool insert(Int32 width, Int32 height, SDL_Point& position);
+
+	private:
+		struct Segment
+		{
+			Int32 x;
+			Int32 y;
+			Int32 width;
+		};
+
+		// Returns the y the rectangle would sit at if placed at segment index,
+		// or -1 if it does not fit there
+		Int32 fit(size_t index, Int32 width, Int32 height) const;
+
+		Int32 m_width;
+		Int32 m_height;
+		containers::Vector<Segment> m_skyline;
+	};
+
+	// Collects loose images and packs them into atlas pages. Used offline to
+	// write an atlas to disk and at runtime to build one in memory.
+	class AtlasBuilder
+	{
+	public:
+		AtlasBuilder(Int32 pageWidth = 2048, Int32 pageHeight = 2048, Int32 padding = 2);
+		~AtlasBuilder();
+
+		AtlasBuilder(const AtlasBuilder&) = delete;
+		AtlasBuilder& operator=(const AtlasBuilder&) = delete;
+
+		// Adds an image under a name, the builder takes ownership of the
+		// surface. Returns false if the name is taken or the image cannot fit
+		// on a page.
+		bool add_image(const String& name, SDL_Surface* surface);
+
+		// Loads an image from disk and adds it
+		bool add_file(const String& name, const String& path);
+
+		// Packs every image added into pages, largest images first
+		bool build();
+
+		// Writes each page as a PNG next to the path and the frame table to
+		// the path itself, in the format TextureAtlas::load reads
+		bool save(const String& path) const;
+
+		const containers::Vector<SDL_Surface*>& pages() const { return m_pages; }
+		const containers::Vector<String>& names() const { return m_names; }
+		const containers::Vector<AtlasFrame>& frames() const { return m_frames; }
+
+	private:
+		Int32 m_pageWidth;
+		Int32 m_pageHeight;
+		Int32 m_padding;
+
+		// Images and names in the order they were added, frames match them
+		containers::Vector<SDL_Surface*> m_images;
+		containers::Vector<String> m_names;
+		containers::Vector<AtlasFrame> m_frames;
+		containers::Vector<SDL_Surface*> m_pages;
+	};
+
+	// A set of atlas pages uploaded as textures and the frame lookup table
+	class TextureAtlas
+	{
+	public:
+		// Returned by frame_id when no frame has the name
+		static const UInt32 InvalidFrame = 0xFFFFFFFF;
+
+		// Loads an atlas written by AtlasBuilder::save
+		bool load(Renderer& renderer, const String& path);
+
+		// Uploads the pages of a built atlas
+		bool load(Renderer& renderer, const AtlasBuilder& builder);
+
+		// Drops every page and frame
+		void clear();
+
+		// Returns the ID of a frame by its name, InvalidFrame if there is none
+		UInt32 frame_id(const String& name) const;
+		UInt32 frame_id(StringId name) const;
+
+		// The page and rectangle of a frame
+		const AtlasFrame& frame(UInt32 id) const { return m_frames[id]; }
+
+		// The texture of a page
+		const GameTexture& page(UInt32 index) const { return *m_pages[index]; }
+
+		UInt32 frame_count() const { return static_cast<UInt32>(m_frames.size()); }
+		UInt32 page_count() const { return static_cast<UInt32>(m_pages.size()); }
+
+	private:
+		containers::Vector<std::unique_ptr<GameTexture>> m_pages;
+		containers::Vector<AtlasFrame> m_frames;
+		containers::UnorderedMap<StringId, UInt32> m_frameIds;
+	};
+}
@@ -0,0 +1,276 @@
+/******************************************************************************
+File: TextureManager.cpp
+Created: 10/18/2026 6:02:30 PM
+Copyright (c) 2017 Turn Tactics
+
+Permission is hereby granted, free of charge, to any person obtaining a copy
+of this software and associated documentation files (the "Software"), to deal
+in the Software without restriction, including without limitation the rights
+to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+copies of the Software, and to permit persons to whom the Software is
+furnished to do so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in
+all copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+SOFTWARE.
+
+Purpose: Contains the texture manager that caches textures by path, hands out
+         reference counted handles and evicts unused textures once the
+         memory budget is exceeded.
+
+Author: James Womack
+
+********************************************************************************/
+#include "TextureManager.h"
+#include "ImageLoader.h"
+#include "../Util/Logger.h"
+#include "../Util/MemoryTracker.h"
+
+#include <utility>
+
+namespace lse
+{
+	TextureHandle::TextureHandle(TextureManager* manager, Entry* entry) :
+		m_manager(manager), m_entry(entry)
+	{
+		if (m_entry != nullptr && m_entry->references++ == 0)
+		{
+			m_manager->on_referenced(m_entry);
+		}
+	}
+
+	TextureHandle::TextureHandle(const TextureHandle& other) :
+		TextureHandle(other.m_manager, other.m_entry)
+	{
+	}
+
+	TextureHandle::TextureHandle(TextureHandle&& other) :
+		m_manager(other.m_manager), m_entry(other.m_entry)
+	{
+		other.m_manager = nullptr;
+		other.m_entry = nullptr;
+	}
+
+	TextureHandle& TextureHandle::operator=(TextureHandle other)
+	{
+		std::swap(m_manager, other.m_manager);
+		std::swap(m_entry, other.m_entry);
+		return *this;
+	}
+
+	void TextureHandle::release()
+	{
+		if (m_entry != nullptr && --m_entry->references == 0)
+		{
+			m_manager->on_unreferenced(m_entry);
+		}
+
+		m_manager = nullptr;
+		m_entry = nullptr;
+	}
+
+	const GameTexture* TextureHandle::get() const
+	{
+		return m_entry != nullptr ? &m_entry->texture : nullptr;
+	}
+
+	TextureManager::TextureManager(Renderer& renderer, JobSystem* jobs, size_t budgetBytes) :
+		m_renderer(renderer), m_jobs(jobs), m_budget(budgetBytes), m_videoBytes(0), m_systemBytes(0)
+	{
+	}
+
+	TextureManager::~TextureManager()
+	{
+		for (const auto& pair : m_entries)
+		{
+			if (pair.second->references > 0)
+			{
+				LSE_LOG_WARNING(Render, "Texture %s still has %u handles when the texture manager was destroyed!",
+					pair.second->path, pair.second->references);
+			}
+
+			LSE_MEMORY_FREE(MemoryTag::Texture, pair.second->videoBytes);
+		}
+	}
+
+	TextureHandle TextureManager::load(const String& path)
+	{
+		TextureHandle handle = find(path);
+		if (handle)
+		{
+			return handle;
+		}
+
+		std::unique_ptr<Entry> entry(new Entry());
+		if (!entry->texture.load_from_file(m_renderer, path))
+		{
+			return TextureHandle();
+		}
+
+		return insert(path, std::move(entry));
+	}
+
+	containers::Vector<TextureHandle> TextureManager::load_all(const containers::Vector<String>& paths)
+	{
+		containers::Vector<TextureHandle> handles(paths.size());
+
+		if (m_jobs == nullptr)
+		{
+			for (size_t i = 0; i < paths.size(); ++i)
+			{
+				handles[i] = load(paths[i]);
+			}
+
+			return handles;
+		}
+
+		// Start decoding every miss before uploading any of them
+		containers::Vector<std::pair<size_t, ImageRequest>> requests;
+		for (size_t i = 0; i < paths.size(); ++i)
+		{
+			handles[i] = find(paths[i]);
+			if (!handles[i])
+			{
+				requests.emplace_back(i, load_image_async(*m_jobs, paths[i]));
+			}
+		}
+
+		for (auto& request : requests)
+		{
+			const String& path = paths[request.first];
+
+			// The same path may be listed more than once
+			handles[request.first] = find(path);
+			if (handles[request.first])
+			{
+				continue;
+			}
+
+			request.second.wait(*m_jobs);
+
+			std::unique_ptr<Entry> entry(new Entry());
+			if (entry->texture.load_from_image(m_renderer, request.second))
+			{
+				handles[request.first] = insert(path, std::move(entry));
+			}
+		}
+
+		return handles;
+	}
+
+	void TextureManager::set_budget(size_t budgetBytes)
+	{
+		m_budget = budgetBytes;
+		trim();
+	}
+
+	void TextureManager::trim()
+	{
+		while (m_videoBytes + m_systemBytes > m_budget && !m_unused.empty())
+		{
+			evict(m_unused.back());
+		}
+	}
+
+	void TextureManager::clear_unused()
+	{
+		while (!m_unused.empty())
+		{
+			evict(m_unused.back());
+		}
+	}
+
+	TextureHandle TextureManager::insert(const String& path, std::unique_ptr<Entry> entry)
+	{
+		Uint32 format = SDL_PIXELFORMAT_UNKNOWN;
+		SDL_QueryTexture(entry->texture.sdl_texture(), &format, nullptr, nullptr, nullptr);
+		const size_t bytesPerPixel = SDL_BYTESPERPIXEL(format) > 0 ? SDL_BYTESPERPIXEL(format) : 4;
+
+		// Another path hashing to the same id keeps its place and this load
+		// fails rather than handing out the wrong texture later
+		entry->id = intern(path);
+		if (m_entries.find(entry->id) != m_entries.end())
+		{
+			LSE_LOG_ERROR(Render, "Texture %s has the same id as a loaded texture and can not be cached!", path);
+			return TextureHandle();
+		}
+
+		entry->path = path;
+		entry->videoBytes = static_cast<size_t>(entry->texture.width()) * entry->texture.height() * bytesPerPixel;
+		entry->systemBytes = sizeof(Entry) + entry->path.capacity();
+
+		m_videoBytes += entry->videoBytes;
+		m_systemBytes += entry->systemBytes;
+
+		Entry* stored = entry.get();
+		m_entries.emplace(stored->id, std::move(entry));
+
+		// Take the handle first so the new texture is not the one evicted, and
+		// evict before charging the tracker so a full cache does not trip the
+		// texture budget
+		TextureHandle handle(this, stored);
+		trim();
+		LSE_MEMORY_ALLOC(MemoryTag::Texture, stored->videoBytes);
+		return handle;
+	}
+
+	TextureHandle TextureManager::find(const String& path)
+	{
+		// Ids are hashes, a different path with the same id is a miss
+		const auto it = m_entries.find(make_string_id(path.data(), path.size()));
+		if (it == m_entries.end() || it->second->path != path)
+		{
+			return TextureHandle();
+		}
+
+		return TextureHandle(this, it->second.get());
+	}
+
+	TextureHandle TextureManager::find(StringId path)
+	{
+		const auto it = m_entries.find(path);
+		if (it == m_entries.end())
+		{
+			return TextureHandle();
+		}
+
+		return TextureHandle(this, it->second.get());
+	}
+
+	void TextureManager::on_referenced(Entry* entry)
+	{
+		if (entry->unused)
+		{
+			m_unused.erase(entry->unusedPosition);
+			entry->unused = false;
+		}
+	}
+
+	void TextureManager::on_unreferenced(Entry* entry)
+	{
+		m_unused.push_front(entry);
+		entry->unusedPosition = m_unused.begin();
+		entry->unused = true;
+
+		trim();
+	}
+
+	void TextureManager::evict(Entry* entry)
+	{
+		m_unused.erase(entry->unusedPosition);
+		m_videoBytes -= entry->videoBytes;
+		m_systemBytes -= entry->systemBytes;
+		LSE_MEMORY_FREE(MemoryTag::Texture, entry->videoBytes);
+
+		// Copy the key, erasing destroys the entry that holds the ID
+		const StringId id = entry->id;
+		m_entries.erase(id);
+	}
+}
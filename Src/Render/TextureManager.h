@@ -0,0 +1,164 @@
+/******************************************************************************
+File: TextureManager.h
+Created: 10/18/2026 6:02:30 PM
+Copyright (c) 2017 Turn Tactics
+
+Permission is hereby granted, free of charge, to any person obtaining a copy
+of this software and associated documentation files (the "Software"), to deal
+in the Software without restriction, including without limitation the rights
+to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+copies of the Software, and to permit persons to whom the Software is
+furnished to do so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in
+all copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+SOFTWARE.
+
+Purpose: Contains the texture manager that caches textures by path, hands out
+         reference counted handles and evicts unused textures once the
+         memory budget is exceeded.
+
+Author: James Womack
+
+********************************************************************************/
+#pragma once
+
+#include "../Common.h"
+#include "../Util/JobSystem.h"
+#include "../Util/StringId.h"
+#include "Renderer.h"
+#include "Texture.h"
+
+#include <list>
+#include <memory>
+
+namespace lse
+{
+	class TextureManager;
+
+	// A counted reference to a texture held by a TextureManager. The texture
+	// stays loaded while any handle to it exists. Handles are not thread safe,
+	// copy and release them on the thread that owns the manager.
+	class TextureHandle
+	{
+	public:
+		TextureHandle() : m_manager(nullptr), m_entry(nullptr) {}
+		~TextureHandle() { release(); }
+
+		TextureHandle(const TextureHandle& other);
+		TextureHandle(TextureHandle&& other);
+		TextureHandle& operator=(TextureHandle other);
+
+		// Drops the reference, the handle is empty afterwards
+		void release();
+
+		// Returns if the handle refers to a loaded texture
+		explicit operator bool() const { return m_entry != nullptr; }
+
+		const GameTexture* get() const;
+		const GameTexture* operator->() const { return get(); }
+		const GameTexture& operator*() const { return *get(); }
+
+	private:
+		friend class TextureManager;
+		struct Entry;
+
+		TextureHandle(TextureManager* manager, Entry* entry);
+
+		TextureManager* m_manager;
+		Entry* m_entry;
+	};
+
+	// Loads each texture once per path and keeps it while handles refer to
+	// it. Textures with no handles stay cached and are evicted least recently
+	// released first whenever the approximate memory used goes over budget.
+	class TextureManager
+	{
+	public:
+		// The job system is optional and only used by load_all to decode in
+		// parallel
+		TextureManager(Renderer& renderer, JobSystem* jobs = nullptr, size_t budgetBytes = 256 * 1024 * 1024);
+		~TextureManager();
+
+		TextureManager(const TextureManager&) = delete;
+		TextureManager& operator=(const TextureManager&) = delete;
+
+		// Returns a handle to the texture at path, loading it if it is not
+		// cached. The handle is empty if loading failed.
+		TextureHandle load(const String& path);
+
+		// Loads many textures, decoding the ones not cached on the job system,
+		// and returns their handles in the same order
+		containers::Vector<TextureHandle> load_all(const containers::Vector<String>& paths);
+
+		// Changes the budget and evicts unused textures to meet it
+		void set_budget(size_t budgetBytes);
+		size_t budget() const { return m_budget; }
+
+		// Evicts unused textures, least recently used first, until the budget
+		// is met or nothing unused is left
+		void trim();
+
+		// Evicts every texture that has no handles
+		void clear_unused();
+
+		// Approximate bytes of texture memory on the GPU
+		size_t video_bytes() const { return m_videoBytes; }
+
+		// Approximate bytes of system memory used for bookkeeping
+		size_t system_bytes() const { return m_systemBytes; }
+
+		// Number of textures cached, used or not
+		UInt32 texture_count() const { return static_cast<UInt32>(m_entries.size()); }
+
+	private:
+		friend class TextureHandle;
+		using Entry = TextureHandle::Entry;
+
+		// Adds a loaded texture to the cache and returns a handle to it
+		TextureHandle insert(const String& path, std::unique_ptr<Entry> entry);
+
+		// Looks up a cached texture and returns a handle, empty if not cached
+		TextureHandle find(const String& path);
+		TextureHandle find(StringId path);
+
+		// Called by handles when the first reference is taken or the last is
+		// dropped to move the entry on or off the unused list
+		void on_referenced(Entry* entry);
+		void on_unreferenced(Entry* entry);
+
+		// Removes an unused entry and frees its texture
+		void evict(Entry* entry);
+
+		Renderer& m_renderer;
+		JobSystem* m_jobs;
+		size_t m_budget;
+		size_t m_videoBytes;
+		size_t m_systemBytes;
+
+		// Entries are boxed so handles can point at them while the map grows
+		containers::UnorderedMap<StringId, std::unique_ptr<Entry>> m_entries;
+
+		// Entries without handles, most recently released at the front
+		std::list<Entry*> m_unused;
+	};
+
+	struct TextureHandle::Entry
+	{
+		StringId id;
+		String path;
+		GameTexture texture;
+		UInt32 references = 0;
+		size_t videoBytes = 0;
+		size_t systemBytes = 0;
+		std::list<Entry*>::iterator unusedPosition;
+		bool unused = false;
+	};
+}
@@ -0,0 +1,264 @@
+/******************************************************************************
+File: Benchmarks.cpp
+Created: 10/24/2026 9:18:06 AM
+Copyright (c) 2017 Turn Tactics
+
+Permission is hereby granted, free of charge, to any person obtaining a copy
+of this software and associated documentation files (the "Software"), to deal
+in the Software without restriction, including without limitation the rights
+to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+copies of the Software, and to permit persons to whom the Software is
+furnished to do so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in
+all copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+SOFTWARE.
+
+Purpose: Throughput benchmarks for engine containers and allocators, run from
+         the command line to compare builds and machines.
+
+Author: James Womack
+
+********************************************************************************/
+#include "Benchmarks.h"
+#include "ConcurrentMemoryPool.h"
+#include "MemoryPool.h"
+#include "../Containers/FlatHashMap.h"
+
+#include <SDL.h>
+#include <algorithm>
+#include <atomic>
+#include <mutex>
+#include <stdio.h>
+#include <thread>
+#include <unordered_map>
+
+namespace lse
+{
+  namespace benchmarks
+  {
+    namespace
+    {
+      // Allocate/free pairs each thread makes per run, in batches so blocks
+      // are live at the same time like in real use
+      const UInt32 PoolOpsPerThread = 2000000;
+      const UInt32 PoolBatchSize = 64;
+
+      struct BenchBlock
+      {
+        UInt8 bytes[64];
+      };
+
+      // Runs work on a number of threads released together and returns the
+      // seconds until the last one finishes
+      template<class TWork>
+      Float64 time_threads(UInt32 threadCount, TWork work)
+      {
+        std::atomic<bool> go(false);
+        containers::Vector<std::thread> threads;
+        for (UInt32 i = 0; i < threadCount; ++i)
+        {
+          threads.emplace_back([&go, &work]()
+          {
+            while (!go.load(std::memory_order_acquire))
+            {
+              std::this_thread::yield();
+            }
+
+            work();
+          });
+        }
+
+        const Uint64 start = SDL_GetPerformanceCounter();
+        go.store(true, std::memory_order_release);
+        for (std::thread& thread : threads)
+        {
+          thread.join();
+        }
+
+        return static_cast<Float64>(SDL_GetPerformanceCounter() - start) / SDL_GetPerformanceFrequency();
+      }
+
+      // Millions of allocate/free pairs per second across all threads
+      template<class TAllocate, class TFree>
+      Float64 pool_throughput(UInt32 threadCount, TAllocate allocate, TFree free)
+      {
+        const Float64 seconds = time_threads(threadCount, [&allocate, &free]()
+        {
+          void* blocks[PoolBatchSize];
+          for (UInt32 done = 0; done < PoolOpsPerThread; done += PoolBatchSize)
+          {
+            for (UInt32 i = 0; i < PoolBatchSize; ++i)
+            {
+              blocks[i] = allocate();
+              static_cast<BenchBlock*>(blocks[i])->bytes[0] = static_cast<UInt8>(i);
+            }
+
+            for (UInt32 i = 0; i < PoolBatchSize; ++i)
+            {
+              free(blocks[i]);
+            }
+          }
+        });
+
+        return threadCount * static_cast<Float64>(PoolOpsPerThread) / seconds / 1000000.0;
+      }
+
+      // Operations each hash map test makes, whatever the map size
+      const UInt32 MapOpsPerTest = 4000000;
+
+      // Nanoseconds per operation of each hash map test
+      struct MapTimes
+      {
+        Float64 insert;
+        Float64 hit;
+        Float64 miss;
+        Float64 iterate;
+      };
+
+      // Keeps results alive so the work is not optimized away
+      volatile Uint64 g_sink;
+
+      Uint64 next_random(Uint64& state)
+      {
+        state ^= state << 13;
+        state ^= state >> 7;
+        state ^= state << 17;
+        return state;
+      }
+
+      Float64 nanoseconds_per_op(Uint64 start, Uint64 ops)
+      {
+        return static_cast<Float64>(SDL_GetPerformanceCounter() - start) * 1000000000.0 /
+          SDL_GetPerformanceFrequency() / ops;
+      }
+
+      // Keys in the map are even, misses are the same keys made odd
+      template<class TMap>
+      MapTimes time_map(const containers::Vector<Uint64>& keys, const containers::Vector<Uint64>& lookups)
+      {
+        const UInt32 rounds = std::max<UInt32>(1, MapOpsPerTest / static_cast<UInt32>(keys.size()));
+        MapTimes times;
+        Uint64 sum = 0;
+
+        // A new map every round so growing is included
+        Uint64 start = SDL_GetPerformanceCounter();
+        for (UInt32 round = 1; round < rounds; ++round)
+        {
+          TMap map;
+          for (Uint64 key : keys)
+          {
+            map.emplace(key, key);
+          }
+          sum += map.size();
+        }
+        TMap map;
+        for (Uint64 key : keys)
+        {
+          map.emplace(key, key);
+        }
+        times.insert = nanoseconds_per_op(start, static_cast<Uint64>(rounds) * keys.size());
+
+        start = SDL_GetPerformanceCounter();
+        for (UInt32 round = 0; round < rounds; ++round)
+        {
+          for (Uint64 key : lookups)
+          {
+            const auto found = map.find(key);
+            sum += found != map.end() ? found->second : 0;
+          }
+        }
+        times.hit = nanoseconds_per_op(start, static_cast<Uint64>(rounds) * lookups.size());
+
+        start = SDL_GetPerformanceCounter();
+        for (UInt32 round = 0; round < rounds; ++round)
+        {
+          for (Uint64 key : lookups)
+          {
+            sum += map.find(key | 1) != map.end() ? 1 : 0;
+          }
+        }
+        times.miss = nanoseconds_per_op(start, static_cast<Uint64>(rounds) * lookups.size());
+
+        start = SDL_GetPerformanceCounter();
+        for (UInt32 round = 0; round < rounds; ++round)
+        {
+          for (const auto& entry : map)
+          {
+            sum += entry.second;
+          }
+        }
+        times.iterate = nanoseconds_per_op(start, static_cast<Uint64>(rounds) * map.size());
+
+        g_sink = sum;
+        return times;
+      }
+    }
+
+    void run_pool_benchmark()
+    {
+      printf("Pool allocate/free pairs, millions per second (%u hardware threads)\n",
+        std::thread::hardware_concurrency());
+      printf("Threads  MemoryPool+mutex  ConcurrentMemoryPool\n");
+
+      for (UInt32 threadCount : { 1u, 2u, 4u, 8u })
+      {
+        MemoryPool<BenchBlock> lockedPool;
+        std::mutex mutex;
+        const Float64 locked = pool_throughput(threadCount,
+          [&]() { std::lock_guard<std::mutex> lock(mutex); return lockedPool.allocate(); },
+          [&](void* block) { std::lock_guard<std::mutex> lock(mutex); lockedPool.deallocate(block); });
+
+        ConcurrentMemoryPool<BenchBlock> concurrentPool;
+        const Float64 concurrent = pool_throughput(threadCount,
+          [&]() { return concurrentPool.allocate(); },
+          [&](void* block) { concurrentPool.deallocate(block); });
+
+        printf("%7u  %16.1f  %20.1f\n", threadCount, locked, concurrent);
+      }
+    }
+
+    void run_hash_map_benchmark()
+    {
+      printf("Hash map of Uint64 keys, nanoseconds per operation\n");
+      printf("%9s  %-10s  %13s  %18s  %7s\n", "Size", "Test", "FlatHashMap", "std::unordered_map", "Speedup");
+
+      for (UInt32 size : { 1000u, 1000000u })
+      {
+        Uint64 state = 0x9E3779B97F4A7C15ull;
+        containers::Vector<Uint64> keys(size);
+        for (Uint64& key : keys)
+        {
+          key = next_random(state) & ~1ull;
+        }
+
+        // Found in a different order than inserted
+        containers::Vector<Uint64> lookups(keys);
+        for (size_t i = lookups.size() - 1; i > 0; --i)
+        {
+          std::swap(lookups[i], lookups[next_random(state) % (i + 1)]);
+        }
+
+        const MapTimes flat = time_map<containers::FlatHashMap<Uint64, Uint64>>(keys, lookups);
+        const MapTimes standard = time_map<std::unordered_map<Uint64, Uint64>>(keys, lookups);
+
+        const auto print = [size](const char* test, Float64 flatTime, Float64 standardTime)
+        {
+          printf("%9u  %-10s  %13.2f  %18.2f  %6.2fx\n", size, test, flatTime, standardTime, standardTime / flatTime);
+        };
+
+        print("insert", flat.insert, standard.insert);
+        print("hit", flat.hit, standard.hit);
+        print("miss", flat.miss, standard.miss);
+        print("iterate", flat.iterate, standard.iterate);
+      }
+    }
+  }
+}
@@ -0,0 +1,46 @@
+/******************************************************************************
+File: Benchmarks.h
+Created: 10/24/2026 9:18:06 AM
+Copyright (c) 2017 Turn Tactics
+
+Permission is hereby granted, free of charge, to any person obtaining a copy
+of this software and associated documentation files (the "Software"), to deal
+in the Software without restriction, including without limitation the rights
+to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+copies of the Software, and to permit persons to whom the Software is
+furnished to do so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in
+all copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+SOFTWARE.
+
+Purpose: Throughput benchmarks for engine containers and allocators, run from
+         the command line to compare builds and machines.
+
+Author: James Womack
+
+********************************************************************************/
+#pragma once
+
+#include "../Common.h"
+
+namespace lse
+{
+  namespace benchmarks
+  {
+    // Prints allocate/free throughput of ConcurrentMemoryPool against a
+    // MemoryPool behind a mutex at 1, 2, 4 and 8 threads
+    void run_pool_benchmark();
+
+    // Prints insert, lookup and iteration times of FlatHashMap against
+    // std::unordered_map for a small and a large map of integer keys
+    void run_hash_map_benchmark();
+  }
+}
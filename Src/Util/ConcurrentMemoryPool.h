@@ -0,0 +1,430 @@
+/******************************************************************************
+File: ConcurrentMemoryPool.h
+Created: 10/19/2026 2:47:53 PM
+Copyright (c) 2017 Turn Tactics
+
+Permission is hereby granted, free of charge, to any person obtaining a copy
+of this software and associated documentation files (the "Software"), to deal
+in the Software without restriction, including without limitation the rights
+to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+copies of the Software, and to permit persons to whom the Software is
+furnished to do so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in
+all copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+SOFTWARE.
+
+Purpose: Wraps a MemoryPool with per thread caches of blocks so several
+         threads can allocate and free from the same pool without fighting
+         over one free list.
+
+Author: James Womack
+
+********************************************************************************/
+#pragma once
+
+#include "MemoryPool.h"
+
+#include <atomic>
+#include <initializer_list>
+#include <mutex>
+
+namespace lse
+{
+  // A MemoryPool that many threads can share. Each thread keeps two
+  // magazines, small stacks of free blocks, and allocates and frees from them
+  // without any synchronization. When both run dry or both fill up a whole
+  // magazine is traded with a shared depot using a single atomic exchange, so
+  // the threads only meet once per MagazineSize operations. The backing pool
+  // is only locked when the depot has nothing to give or no room to take.
+  //
+  // Caches are indexed by a number each thread takes when it first touches a
+  // pool of this type and gives back when it exits, at most MaxThreads
+  // threads have one at a time and any more fall back to locking the backing
+  // pool on every call. Blocks in a thread's cache stay there when the thread
+  // exits, for the next thread given its number, unless it calls
+  // flush_thread_cache.
+  //
+  // The debug checks of MemoryPool only run when blocks move in and out of
+  // the backing pool, not on every allocate and free. Likewise blocks sitting
+  // in caches and the depot are still charged to the pool's memory tag.
+  template<class T, size_t BlocksPerSlab = 256, size_t MagazineSize = 32>
+  class ConcurrentMemoryPool
+  {
+  public:
+    static_assert(MagazineSize > 0, "A magazine needs room for at least one block");
+
+    // Threads that get their own cache
+    static const UInt32 MaxThreads = 64;
+
+    // Magazines the depot can hold of each kind
+    static const UInt32 DepotSlots = 64;
+
+    explicit ConcurrentMemoryPool(MemoryTag tag = MemoryTag::General) :
+      m_pool(tag)
+    {
+      for (UInt32 i = 0; i < DepotSlots; ++i)
+      {
+        m_fullSlots[i].store(nullptr, std::memory_order_relaxed);
+        m_emptySlots[i].store(nullptr, std::memory_order_relaxed);
+      }
+
+      for (Cache& cache : m_caches)
+      {
+        cache.loaded = nullptr;
+        cache.previous = nullptr;
+      }
+    }
+
+    // Every thread must be done with the pool before it is destroyed
+    ~ConcurrentMemoryPool()
+    {
+      for (Cache& cache : m_caches)
+      {
+        release_magazine(cache.loaded);
+        release_magazine(cache.previous);
+      }
+
+      for (UInt32 i = 0; i < DepotSlots; ++i)
+      {
+        release_magazine(m_fullSlots[i].exchange(nullptr, std::memory_order_acquire));
+        delete m_emptySlots[i].exchange(nullptr, std::memory_order_acquire);
+      }
+    }
+
+    ConcurrentMemoryPool(const ConcurrentMemoryPool&) = delete;
+    ConcurrentMemoryPool& operator=(const ConcurrentMemoryPool&) = delete;
+
+    // Returns an uninitialized block big enough for a T
+    void* allocate()
+    {
+      Cache* cache = thread_cache();
+      if (cache == nullptr)
+      {
+        std::lock_guard<std::mutex> lock(m_poolMutex);
+        return m_pool.allocate();
+      }
+
+      for (;;)
+      {
+        if (cache->loaded->count > 0)
+        {
+          return cache->loaded->blocks[--cache->loaded->count];
+        }
+
+        // The other magazine is either full or empty
+        if (cache->previous->count > 0)
+        {
+          std::swap(cache->loaded, cache->previous);
+          continue;
+        }
+
+        // Both are empty, trade one for a full magazine from the depot or
+        // fill one from the backing pool
+        Magazine* full = take(m_fullSlots);
+        if (full != nullptr)
+        {
+          put_empty(cache->previous);
+          cache->previous = cache->loaded;
+          cache->loaded = full;
+        }
+        else
+        {
+          fill(cache->loaded);
+        }
+      }
+    }
+
+    // Returns a block to the pool, null is ignored. Blocks may be freed on a
+    // different thread than the one that allocated them.
+    void deallocate(void* pointer)
+    {
+      if (pointer == nullptr)
+      {
+        return;
+      }
+
+      Cache* cache = thread_cache();
+      if (cache == nullptr)
+      {
+        std::lock_guard<std::mutex> lock(m_poolMutex);
+        m_pool.deallocate(pointer);
+        return;
+      }
+
+      if (cache->loaded->count == MagazineSize)
+      {
+        if (cache->previous->count < MagazineSize)
+        {
+          std::swap(cache->loaded, cache->previous);
+        }
+        else
+        {
+          // Both are full, hand one to the depot and continue with an empty
+          // magazine. A full depot gets the blocks back in the backing pool.
+          Magazine* full = cache->previous;
+          if (!put(m_fullSlots, full))
+          {
+            drain(full);
+            cache->previous = cache->loaded;
+            cache->loaded = full;
+          }
+          else
+          {
+            cache->previous = cache->loaded;
+            cache->loaded = take_empty();
+          }
+        }
+      }
+
+      cache->loaded->blocks[cache->loaded->count++] = pointer;
+    }
+
+    // Allocates a block and constructs a T in it
+    template<class... TArgs>
+    T* create(TArgs&&... args)
+    {
+      void* block = allocate();
+      return new (block) T(std::forward<TArgs>(args)...);
+    }
+
+    // Destroys a T made by create and frees its block, null is ignored
+    void destroy(T* object)
+    {
+      if (object != nullptr)
+      {
+        object->~T();
+        deallocate(object);
+      }
+    }
+
+    // Hands the calling thread's cached blocks back to the depot or the
+    // backing pool, call it before a thread that used the pool exits
+    void flush_thread_cache()
+    {
+      Cache* cache = thread_cache();
+      if (cache == nullptr)
+      {
+        return;
+      }
+
+      for (Magazine** magazine : { &cache->loaded, &cache->previous })
+      {
+        if ((*magazine)->count == 0 || !put(m_fullSlots, *magazine))
+        {
+          drain(*magazine);
+          put_empty(*magazine);
+        }
+
+        *magazine = nullptr;
+      }
+    }
+
+    // Bytes of memory taken from the heap for slabs
+    size_t reserved_bytes()
+    {
+      std::lock_guard<std::mutex> lock(m_poolMutex);
+      return m_pool.reserved_bytes();
+    }
+
+  private:
+    struct Magazine
+    {
+      size_t count;
+      void* blocks[MagazineSize];
+    };
+
+    // Only ever touched by the thread it belongs to. Aligned to a cache line
+    // so neighbouring threads do not share one.
+    struct alignas(CacheLineSize) Cache
+    {
+      Magazine* loaded;
+      Magazine* previous;
+    };
+
+    // Cache numbers not held by a running thread
+    struct ThreadIndices
+    {
+      std::mutex mutex;
+      UInt32 next = 0;
+      containers::Vector<UInt32> free;
+    };
+
+    static ThreadIndices& thread_indices()
+    {
+      static ThreadIndices s_indices;
+      return s_indices;
+    }
+
+    // Gives a thread's number back when it exits. Anything the thread frees
+    // into a pool after that, from other thread_local destructors, takes
+    // the locked path.
+    struct ThreadSlot
+    {
+      UInt32& index;
+
+      ~ThreadSlot()
+      {
+        ThreadIndices& indices = thread_indices();
+        std::lock_guard<std::mutex> lock(indices.mutex);
+        indices.free.push_back(index);
+        index = MaxThreads;
+      }
+    };
+
+    // The calling thread's number, MaxThreads if it has no cache
+    static UInt32 thread_index()
+    {
+      static const UInt32 Unassigned = ~0u;
+
+      // Trivially destructible so it can still be read while the thread exits
+      thread_local UInt32 t_index = Unassigned;
+      if (t_index == Unassigned)
+      {
+        ThreadIndices& indices = thread_indices();
+        {
+          std::lock_guard<std::mutex> lock(indices.mutex);
+          if (!indices.free.empty())
+          {
+            t_index = indices.free.back();
+            indices.free.pop_back();
+          }
+          else
+          {
+            t_index = indices.next < MaxThreads ? indices.next++ : MaxThreads;
+          }
+        }
+
+        if (t_index < MaxThreads)
+        {
+          thread_local ThreadSlot t_slot{ t_index };
+        }
+      }
+
+      return t_index;
+    }
+
+    // The calling thread's cache with both magazines present, or null if the
+    // thread has no cache
+    Cache* thread_cache()
+    {
+      const UInt32 index = thread_index();
+      if (index >= MaxThreads)
+      {
+        return nullptr;
+      }
+
+      Cache& cache = m_caches[index];
+      if (cache.loaded == nullptr)
+      {
+        cache.loaded = take_empty();
+        cache.previous = take_empty();
+      }
+
+      return &cache;
+    }
+
+    // Takes a magazine out of any occupied slot, or null if all are empty.
+    // Scanning starts at a different slot for each thread to spread them out.
+    Magazine* take(std::atomic<Magazine*>* slots)
+    {
+      const UInt32 start = thread_index();
+      for (UInt32 i = 0; i < DepotSlots; ++i)
+      {
+        std::atomic<Magazine*>& slot = slots[(start + i) % DepotSlots];
+        if (slot.load(std::memory_order_relaxed) != nullptr)
+        {
+          Magazine* magazine = slot.exchange(nullptr, std::memory_order_acquire);
+          if (magazine != nullptr)
+          {
+            return magazine;
+          }
+        }
+      }
+
+      return nullptr;
+    }
+
+    // Stores a magazine in any free slot, returns false if none are free
+    bool put(std::atomic<Magazine*>* slots, Magazine* magazine)
+    {
+      const UInt32 start = thread_index();
+      for (UInt32 i = 0; i < DepotSlots; ++i)
+      {
+        std::atomic<Magazine*>& slot = slots[(start + i) % DepotSlots];
+        Magazine* expected = nullptr;
+        if (slot.load(std::memory_order_relaxed) == nullptr &&
+          slot.compare_exchange_strong(expected, magazine, std::memory_order_release, std::memory_order_relaxed))
+        {
+          return true;
+        }
+      }
+
+      return false;
+    }
+
+    Magazine* take_empty()
+    {
+      Magazine* magazine = take(m_emptySlots);
+      if (magazine == nullptr)
+      {
+        magazine = new Magazine;
+        magazine->count = 0;
+      }
+
+      return magazine;
+    }
+
+    void put_empty(Magazine* magazine)
+    {
+      if (!put(m_emptySlots, magazine))
+      {
+        delete magazine;
+      }
+    }
+
+    // Fills an empty magazine from the backing pool
+    void fill(Magazine* magazine)
+    {
+      std::lock_guard<std::mutex> lock(m_poolMutex);
+      while (magazine->count < MagazineSize)
+      {
+        magazine->blocks[magazine->count++] = m_pool.allocate();
+      }
+    }
+
+    // Empties a magazine into the backing pool
+    void drain(Magazine* magazine)
+    {
+      std::lock_guard<std::mutex> lock(m_poolMutex);
+      while (magazine->count > 0)
+      {
+        m_pool.deallocate(magazine->blocks[--magazine->count]);
+      }
+    }
+
+    // Drains and deletes a magazine, null is ignored
+    void release_magazine(Magazine* magazine)
+    {
+      if (magazine != nullptr)
+      {
+        drain(magazine);
+        delete magazine;
+      }
+    }
+
+    std::mutex m_poolMutex;
+    MemoryPool<T, BlocksPerSlab> m_pool;
+
+    std::atomic<Magazine*> m_fullSlots[DepotSlots];
+    std::atomic<Magazine*> m_emptySlots[DepotSlots];
+    Cache m_caches[MaxThreads];
+  };
+}
@@ -0,0 +1,287 @@
+/******************************************************************************
+File: CrashLogRing.cpp
+Created: 10/23/2026 11:05:18 AM
+Copyright (c) 2017 Turn Tactics
+
+Permission is hereby granted, free of charge, to any person obtaining a copy
+of this software and associated documentation files (the "Software"), to deal
+in the Software without restriction, including without limitation the rights
+to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+copies of the Software, and to permit persons to whom the Software is
+furnished to do so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in
+all copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+SOFTWARE.
+
+Purpose: A memory mapped ring of the most recent log messages that survives the
+         game crashing, and the recovery that reads it back.
+
+Author: James Womack
+
+********************************************************************************/
+#include "CrashLogRing.h"
+
+#include <cstdio>
+
+namespace lse
+{
+  namespace
+  {
+    const char RingMagic[8] = "LSERING";
+    const UInt32 RingVersion = 1;
+
+    // Start of the file, the cursor and format count are updated live
+    struct Header
+    {
+      char magic[8];
+      UInt32 version;
+      UInt32 slotCount;
+      UInt32 formatBytes;
+
+      // 1 once the game closed the ring, 0 while it is in use
+      UInt32 closed;
+      Uint64 frequency;
+      Uint64 origin;
+
+      // Sequence number of the next message
+      std::atomic<Uint64> cursor;
+
+      // Bytes of the format area in use
+      std::atomic<UInt32> formatUsed;
+    };
+
+    const size_t HeaderBytes = 64;
+
+    // Stamped on a slot while a thread is writing it
+    const Uint64 SlotWriting = ~Uint64(0);
+
+    // One message. Sequence is the message's sequence number plus one once
+    // written, SlotWriting while it is being written and 0 if never used.
+    struct Slot
+    {
+      std::atomic<Uint64> sequence;
+      Uint64 time;
+      UInt32 thread;
+      logger::FormatId format;
+      LogLevel level;
+      LogCategory category;
+      UInt16 size;
+      UInt8 payload[logger::MaxPayloadSize];
+    };
+
+    static_assert(sizeof(Header) <= HeaderBytes, "Header must fit before the format area");
+    static_assert(sizeof(Slot) == 256, "Slots should stay a power of two in size");
+    static_assert(std::atomic<Uint64>::is_always_lock_free, "Shared atomics must not use a lock");
+
+    size_t file_bytes(UInt32 slots)
+    {
+      return HeaderBytes + CrashLogRing::FormatBytes + static_cast<size_t>(slots) * sizeof(Slot);
+    }
+
+    Header* header(UInt8* data)
+    {
+      return reinterpret_cast<Header*>(data);
+    }
+
+    Slot* slots(UInt8* data)
+    {
+      return reinterpret_cast<Slot*>(data + HeaderBytes + CrashLogRing::FormatBytes);
+    }
+
+    // Returns if a mapped file looks like a complete ring
+    bool is_ring(const MappedFile& file)
+    {
+      const Header* head = reinterpret_cast<const Header*>(file.data());
+      return file.size() >= HeaderBytes && std::memcmp(head->magic, RingMagic, sizeof(RingMagic)) == 0 &&
+        head->version == RingVersion && head->formatBytes == CrashLogRing::FormatBytes && head->slotCount > 0 &&
+        head->frequency != 0 && file.size() >= file_bytes(head->slotCount);
+    }
+  }
+
+  CrashLogRing::CrashLogRing() : m_slotCount(0)
+  {
+  }
+
+  CrashLogRing::~CrashLogRing()
+  {
+    close();
+  }
+
+  bool CrashLogRing::open(const String& path, UInt32 slots, Uint64 frequency, Uint64 origin)
+  {
+    close();
+
+    // Keep the messages from a run that did not close its ring
+    {
+      MappedFile previous;
+      if (previous.open_read(path) && is_ring(previous) && header(previous.data())->closed == 0)
+      {
+        previous.close();
+
+        const String crashPath = path + ".crash";
+        std::remove(crashPath.c_str());
+        if (std::rename(path.c_str(), crashPath.c_str()) == 0)
+        {
+          printf("The last run did not close its log, kept it as %s\n", crashPath.c_str());
+        }
+      }
+    }
+
+    if (slots == 0 || !m_file.create(path, file_bytes(slots)))
+    {
+      printf("Unable to create log ring %s!\n", path.c_str());
+      return false;
+    }
+
+    Header* head = header(m_file.data());
+    head->version = RingVersion;
+    head->slotCount = slots;
+    head->formatBytes = FormatBytes;
+    head->closed = 0;
+    head->frequency = frequency;
+    head->origin = origin;
+    head->cursor.store(0, std::memory_order_relaxed);
+    head->formatUsed.store(0, std::memory_order_relaxed);
+
+    // The magic goes last so a half made file is never read as a ring
+    std::memcpy(head->magic, RingMagic, sizeof(RingMagic));
+    m_slotCount = slots;
+    return true;
+  }
+
+  void CrashLogRing::close()
+  {
+    if (!m_file.is_open())
+    {
+      return;
+    }
+
+    header(m_file.data())->closed = 1;
+    m_file.close();
+    m_slotCount = 0;
+  }
+
+  void CrashLogRing::add_format(logger::FormatId id, const char* format)
+  {
+    Header* head = header(m_file.data());
+    const UInt32 used = head->formatUsed.load(std::memory_order_relaxed);
+    const size_t length = std::strlen(format);
+    const size_t bytes = sizeof(id) + sizeof(UInt16) + length;
+    if (length > 0xFFFF || used + bytes > FormatBytes)
+    {
+      // Messages using it are recovered with their arguments only
+      return;
+    }
+
+    const UInt16 stored = static_cast<UInt16>(length);
+    UInt8* entry = m_file.data() + HeaderBytes + used;
+    std::memcpy(entry, &id, sizeof(id));
+    std::memcpy(entry + sizeof(id), &stored, sizeof(stored));
+    std::memcpy(entry + sizeof(id) + sizeof(stored), format, length);
+    head->formatUsed.store(used + static_cast<UInt32>(bytes), std::memory_order_release);
+  }
+
+  void CrashLogRing::write(Uint64 time, UInt32 thread, LogLevel level, LogCategory category, logger::FormatId format,
+    const UInt8* payload, UInt32 size)
+  {
+    const Uint64 sequence = header(m_file.data())->cursor.fetch_add(1, std::memory_order_relaxed);
+    Slot& slot = slots(m_file.data())[sequence % m_slotCount];
+
+    // Claim the slot so two writers a full ring apart never fill it at once.
+    // The message is dropped if the slot is taken or already holds a newer
+    // message, losing one line beats recovering a torn one.
+    Uint64 stamp = slot.sequence.load(std::memory_order_relaxed);
+    if (stamp == SlotWriting || stamp > sequence ||
+      !slot.sequence.compare_exchange_strong(stamp, SlotWriting, std::memory_order_acquire, std::memory_order_relaxed))
+    {
+      return;
+    }
+    std::atomic_thread_fence(std::memory_order_release);
+    slot.time = time;
+    slot.thread = thread;
+    slot.format = format;
+    slot.level = level;
+    slot.category = category;
+    slot.size = static_cast<UInt16>(size);
+    std::memcpy(slot.payload, payload, size);
+    slot.sequence.store(sequence + 1, std::memory_order_release);
+  }
+
+  bool CrashLogRing::recover(const String& path, std::ostream& out)
+  {
+    MappedFile file;
+    if (!file.open_read(path))
+    {
+      printf("Unable to open log ring %s!\n", path.c_str());
+      return false;
+    }
+
+    if (!is_ring(file))
+    {
+      printf("%s is not a log ring!\n", path.c_str());
+      return false;
+    }
+
+    // The file is mapped read only, nothing is written through these
+    UInt8* data = const_cast<UInt8*>(file.data());
+    const Header* head = header(data);
+    const Slot* ring = slots(data);
+
+    containers::UnorderedMap<logger::FormatId, String> formats;
+    const UInt8* entry = data + HeaderBytes;
+    const UInt8* formatEnd = entry + std::min(head->formatUsed.load(), FormatBytes);
+    while (formatEnd - entry >= static_cast<std::ptrdiff_t>(sizeof(logger::FormatId) + sizeof(UInt16)))
+    {
+      logger::FormatId id;
+      UInt16 length;
+      std::memcpy(&id, entry, sizeof(id));
+      std::memcpy(&length, entry + sizeof(id), sizeof(length));
+      entry += sizeof(id) + sizeof(length);
+      if (formatEnd - entry < length)
+      {
+        break;
+      }
+
+      formats[id] = String(reinterpret_cast<const char*>(entry), length);
+      entry += length;
+    }
+
+    // Only the last slotCount messages can still be in the ring
+    const Uint64 end = head->cursor.load();
+    const Uint64 begin = end > head->slotCount ? end - head->slotCount : 0;
+    UInt32 recovered = 0;
+    UInt32 damaged = 0;
+
+    String line;
+    for (Uint64 sequence = begin; sequence < end; ++sequence)
+    {
+      const Slot& slot = ring[sequence % head->slotCount];
+      if (slot.sequence.load() != sequence + 1 || slot.size > logger::MaxPayloadSize)
+      {
+        ++damaged;
+        continue;
+      }
+
+      const auto format = formats.find(slot.format);
+      const Float64 seconds = static_cast<Float64>(slot.time - head->origin) / head->frequency;
+      line.clear();
+      logger::format_line(line, seconds, slot.level, slot.category, slot.thread,
+        format != formats.end() ? format->second.c_str() : "%s", slot.payload, slot.size);
+      out.write(line.data(), static_cast<std::streamsize>(line.size()));
+      ++recovered;
+    }
+
+    out.flush();
+    printf("Recovered %u messages from %s, %u were incomplete, the game %s\n", recovered, path.c_str(), damaged,
+      head->closed != 0 ? "closed cleanly" : "did not close cleanly");
+    return true;
+  }
+}
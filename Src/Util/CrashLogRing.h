@@ -0,0 +1,80 @@
+/******************************************************************************
+File: CrashLogRing.h
+Created: 10/23/2026 11:05:18 AM
+Copyright (c) 2017 Turn Tactics
+
+Permission is hereby granted, free of charge, to any person obtaining a copy
+of this software and associated documentation files (the "Software"), to deal
+in the Software without restriction, including without limitation the rights
+to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+copies of the Software, and to permit persons to whom the Software is
+furnished to do so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in
+all copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+SOFTWARE.
+
+Purpose: A memory mapped ring of the most recent log messages that survives the
+         game crashing, and the recovery that reads it back.
+
+Author: James Womack
+
+********************************************************************************/
+#pragma once
+
+#include "Logger.h"
+#include "MappedFile.h"
+
+namespace lse
+{
+  // Keeps the last messages logged in a memory mapped file. Messages are
+  // copied in by the thread that logs them, before they reach the logger's
+  // queue, so nothing waits in memory the OS would lose if the game dies.
+  //
+  // The file holds a header with the write cursor, the format strings in use
+  // and a ring of fixed size slots. Each slot is stamped with its sequence
+  // number once it is complete, recovery skips slots a crash left half
+  // written or that were overwritten out of order.
+  class CrashLogRing
+  {
+  public:
+    // Bytes of the file set aside for format strings
+    static constexpr UInt32 FormatBytes = 64 * 1024;
+
+    CrashLogRing();
+    ~CrashLogRing();
+
+    // Creates the ring file with room for the given number of messages. A
+    // ring left behind by a crash is first moved to PATH.crash.
+    bool open(const String& path, UInt32 slots, Uint64 frequency, Uint64 origin);
+
+    // Marks the ring as closed cleanly and writes it out
+    void close();
+
+    bool is_open() const { return m_file.is_open(); }
+
+    // Records a format string so recovery can print messages using it.
+    // Called with the format table locked.
+    void add_format(logger::FormatId id, const char* format);
+
+    // Copies a message into the next slot, safe from any thread. The message
+    // is dropped if a writer a full ring ahead or behind holds the slot.
+    void write(Uint64 time, UInt32 thread, LogLevel level, LogCategory category, logger::FormatId format,
+      const UInt8* payload, UInt32 size);
+
+    // Prints the messages in a ring file oldest first, returns false if the
+    // file could not be read or is not a log ring
+    static bool recover(const String& path, std::ostream& out);
+
+  private:
+    MappedFile m_file;
+    UInt32 m_slotCount;
+  };
+}
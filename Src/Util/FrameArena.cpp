@@ -0,0 +1,107 @@
+/******************************************************************************
+File: FrameArena.cpp
+Created: 10/19/2026 10:31:17 AM
+Copyright (c) 2017 Turn Tactics
+
+Permission is hereby granted, free of charge, to any person obtaining a copy
+of this software and associated documentation files (the "Software"), to deal
+in the Software without restriction, including without limitation the rights
+to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+copies of the Software, and to permit persons to whom the Software is
+furnished to do so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in
+all copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+SOFTWARE.
+
+Purpose: Defines the linear arena used for data that only lives for a frame, a
+         double buffered arena for data that has to survive into the next
+         frame and an STL allocator that allocates from either.
+
+Author: James Womack
+
+********************************************************************************/
+#include "FrameArena.h"
+
+#include <algorithm>
+#include <cstdint>
+#include <new>
+
+namespace lse
+{
+  namespace
+  {
+    inline UInt8* align_up(UInt8* pointer, size_t alignment)
+    {
+      const std::uintptr_t address = reinterpret_cast<std::uintptr_t>(pointer);
+      return reinterpret_cast<UInt8*>((address + alignment - 1) / alignment * alignment);
+    }
+  }
+
+  LinearArena::LinearArena(size_t capacity, MemoryTag tag) :
+    m_tag(tag), m_buffer(static_cast<UInt8*>(::operator new(capacity))), m_capacity(capacity), m_offset(0),
+    m_allocations(0), m_overflowBytes(0), m_lastFramePeak(0), m_peak(0)
+  {
+  }
+
+  LinearArena::~LinearArena()
+  {
+    reset();
+    ::operator delete(m_buffer);
+  }
+
+  void* LinearArena::allocate(size_t size, size_t alignment)
+  {
+    UInt8* const start = align_up(m_buffer + m_offset, alignment);
+    const size_t end = static_cast<size_t>(start - m_buffer) + size;
+
+    ++m_allocations;
+
+    if (end <= m_capacity)
+    {
+      LSE_MEMORY_ALLOC(m_tag, end - m_offset);
+      m_offset = end;
+      return start;
+    }
+
+    // Out of room, borrow from the heap until the next reset grows the buffer
+    void* block = ::operator new(size + alignment);
+    m_overflow.push_back(block);
+    m_overflowBytes += size;
+    LSE_MEMORY_ALLOC(m_tag, size);
+    return align_up(static_cast<UInt8*>(block), alignment);
+  }
+
+  void LinearArena::reset()
+  {
+    m_lastFramePeak = used();
+    m_peak = std::max(m_peak, m_lastFramePeak);
+    LSE_MEMORY_FREE_MANY(m_tag, m_lastFramePeak, m_allocations);
+    m_allocations = 0;
+
+    for (void* block : m_overflow)
+    {
+      ::operator delete(block);
+    }
+    m_overflow.clear();
+
+    // Grow so a frame like this one fits without touching the heap
+    if (m_overflowBytes > 0)
+    {
+      const size_t capacity = std::max(m_capacity * 2, m_lastFramePeak + m_lastFramePeak / 2);
+      ::operator delete(m_buffer);
+      m_buffer = static_cast<UInt8*>(::operator new(capacity));
+      m_capacity = capacity;
+      m_overflowBytes = 0;
+    }
+
+    m_offset = 0;
+  }
+}
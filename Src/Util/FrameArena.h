@@ -0,0 +1,180 @@
+/******************************************************************************
+File: FrameArena.h
+Created: 10/19/2026 10:31:17 AM
+Copyright (c) 2017 Turn Tactics
+
+Permission is hereby granted, free of charge, to any person obtaining a copy
+of this software and associated documentation files (the "Software"), to deal
+in the Software without restriction, including without limitation the rights
+to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+copies of the Software, and to permit persons to whom the Software is
+furnished to do so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in
+all copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+SOFTWARE.
+
+Purpose: Defines the linear arena used for data that only lives for a frame, a
+         double buffered arena for data that has to survive into the next
+         frame and an STL allocator that allocates from either.
+
+Author: James Womack
+
+********************************************************************************/
+#pragma once
+
+#include "../Common.h"
+#include "MemoryTracker.h"
+
+#include <cstddef>
+#include <type_traits>
+#include <utility>
+
+namespace lse
+{
+  // Hands out memory by bumping an offset through one buffer and frees all
+  // of it at once on reset. When a frame needs more than the buffer holds
+  // the extra comes from the heap and the buffer grows on the next reset, so
+  // a steady workload stops touching the heap after a frame or two. Not
+  // thread safe, give each thread its own arena. Allocations are charged to
+  // the arena's memory tag until the reset that frees them.
+  class LinearArena
+  {
+  public:
+    explicit LinearArena(size_t capacity = 1024 * 1024, MemoryTag tag = MemoryTag::Frame);
+    ~LinearArena();
+
+    LinearArena(const LinearArena&) = delete;
+    LinearArena& operator=(const LinearArena&) = delete;
+
+    // Returns size bytes aligned to alignment, valid until the next reset
+    void* allocate(size_t size, size_t alignment = alignof(std::max_align_t));
+
+    // Constructs a T in the arena. Destructors are never run so only types
+    // that do not need one are allowed.
+    template<class T, class... TArgs>
+    T* create(TArgs&&... args)
+    {
+      static_assert(std::is_trivially_destructible<T>::value, "Arena objects are never destroyed");
+      return new (allocate(sizeof(T), alignof(T))) T(std::forward<TArgs>(args)...);
+    }
+
+    // Frees everything allocated since the last reset and records the peak
+    void reset();
+
+    // Bytes allocated since the last reset, including any heap overflow
+    size_t used() const { return m_offset + m_overflowBytes; }
+
+    // Size of the buffer allocations are bumped through
+    size_t capacity() const { return m_capacity; }
+
+    // Bytes used by the frame that ended at the last reset
+    size_t last_frame_peak() const { return m_lastFramePeak; }
+
+    // The most bytes any frame has used
+    size_t peak() const { return m_peak; }
+
+  private:
+    MemoryTag m_tag;
+    UInt8* m_buffer;
+    size_t m_capacity;
+    size_t m_offset;
+    size_t m_allocations;
+
+    // Heap blocks taken this frame after the buffer ran out
+    containers::Vector<void*> m_overflow;
+    size_t m_overflowBytes;
+
+    size_t m_lastFramePeak;
+    size_t m_peak;
+  };
+
+  // Two arenas that swap each frame. Allocations made this frame stay valid
+  // until the end of the next one, which suits data built in one frame and
+  // consumed in the next.
+  class DoubleBufferedArena
+  {
+  public:
+    explicit DoubleBufferedArena(size_t capacity = 1024 * 1024, MemoryTag tag = MemoryTag::Frame) :
+      m_first(capacity, tag), m_second(capacity, tag), m_current(&m_first), m_previous(&m_second)
+    {
+    }
+
+    DoubleBufferedArena(const DoubleBufferedArena&) = delete;
+    DoubleBufferedArena& operator=(const DoubleBufferedArena&) = delete;
+
+    // The arena to allocate from this frame
+    LinearArena& current() { return *m_current; }
+
+    // The arena that was current last frame, its data is still valid
+    LinearArena& previous() { return *m_previous; }
+
+    // Ends the frame, the previous arena is reset and becomes current
+    void swap()
+    {
+      std::swap(m_current, m_previous);
+      m_current->reset();
+    }
+
+  private:
+    LinearArena m_first;
+    LinearArena m_second;
+    LinearArena* m_current;
+    LinearArena* m_previous;
+  };
+
+  // STL allocator that allocates from a LinearArena and never frees, memory
+  // comes back when the arena resets. Containers using it must not outlive
+  // the frame.
+  template<class T>
+  class ArenaAllocator
+  {
+  public:
+    using value_type = T;
+
+    explicit ArenaAllocator(LinearArena& arena) : m_arena(&arena) {}
+
+    template<class U>
+    ArenaAllocator(const ArenaAllocator<U>& other) : m_arena(other.arena()) {}
+
+    T* allocate(size_t count)
+    {
+      return static_cast<T*>(m_arena->allocate(count * sizeof(T), alignof(T)));
+    }
+
+    void deallocate(T*, size_t)
+    {
+    }
+
+    LinearArena* arena() const { return m_arena; }
+
+  private:
+    LinearArena* m_arena;
+  };
+
+  template<class T, class U>
+  bool operator==(const ArenaAllocator<T>& a, const ArenaAllocator<U>& b)
+  {
+    return a.arena() == b.arena();
+  }
+
+  template<class T, class U>
+  bool operator!=(const ArenaAllocator<T>& a, const ArenaAllocator<U>& b)
+  {
+    return a.arena() != b.arena();
+  }
+
+  namespace containers
+  {
+    // A vector whose storage lives in a frame arena
+    template<class TValue>
+    using ArenaVector = Vector<TValue, ArenaAllocator<TValue>>;
+  }
+}
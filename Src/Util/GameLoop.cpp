@@ -0,0 +1,363 @@
+/******************************************************************************
+File: GameLoop.cpp
+Created: 10/17/2026 9:12:05 AM
+Copyright (c) 2017 Turn Tactics
+
+Permission is hereby granted, free of charge, to any person obtaining a copy
+of this software and associated documentation files (the "Software"), to deal
+in the Software without restriction, including without limitation the rights
+to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+copies of the Software, and to permit persons to whom the Software is
+furnished to do so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in
+all copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+SOFTWARE.
+
+Purpose: Contains the main loop scheduler that runs simulation ticks at a fixed
+         rate, paces rendered frames and sleeps when nothing is animating.
+
+Author: James Womack
+
+********************************************************************************/
+#include "GameLoop.h"
+#include "Profiler.h"
+
+#include <algorithm>
+#include <chrono>
+#include <thread>
+
+namespace lse
+{
+  GameLoop::GameLoop(GameLoopSettings settings) :
+    m_settings(settings), m_tickCount(0), m_quit(false), m_redraw(true),
+    m_simulateOnce(true), m_tickDone(false), m_wakeEvent(SDL_RegisterEvents(1)), m_wakePending(false)
+  {
+    m_settings.tickRate = std::max<UInt32>(m_settings.tickRate, 1);
+    m_settings.maxTicksPerFrame = std::max<UInt32>(m_settings.maxTicksPerFrame, 1);
+
+    m_frequency = SDL_GetPerformanceFrequency();
+    m_tickLength = m_frequency / m_settings.tickRate;
+    m_frameLength = m_settings.maxFrameRate > 0
+      ? m_frequency / m_settings.maxFrameRate : m_tickLength;
+  }
+
+  void GameLoop::quit()
+  {
+    m_quit = true;
+    wake_simulation();
+    wake_events();
+  }
+
+  void GameLoop::request_redraw()
+  {
+    m_redraw = true;
+    wake_events();
+  }
+
+  void GameLoop::run()
+  {
+    LSE_PROFILE_THREAD("Main");
+
+    const Float64 tickSeconds = 1.0 / m_settings.tickRate;
+
+    Uint64 previous = SDL_GetPerformanceCounter();
+    Uint64 nextFrame = previous;
+    Uint64 accumulator = 0;
+
+    while (!m_quit)
+    {
+      if (!m_redraw && !is_animating())
+      {
+        // Nothing to simulate or draw so sleep on the event queue until the
+        // player does something
+        if (wait_for_events(m_settings.idleTimeoutMs))
+        {
+          m_redraw = true;
+        }
+
+        // Time spent idle is not simulated, otherwise waking up would run a
+        // burst of catch up ticks
+        previous = SDL_GetPerformanceCounter();
+        nextFrame = previous;
+        accumulator = 0;
+        continue;
+      }
+
+      if (poll_events())
+      {
+        m_redraw = true;
+      }
+
+      if (m_quit)
+      {
+        break;
+      }
+
+      const Uint64 now = SDL_GetPerformanceCounter();
+      accumulator += now - previous;
+      previous = now;
+
+      // Run fixed ticks until the simulation has caught up with real time
+      UInt32 ticks = 0;
+      while (accumulator >= m_tickLength && ticks < m_settings.maxTicksPerFrame)
+      {
+        if (m_onUpdate)
+        {
+          m_onUpdate(tickSeconds);
+        }
+
+        accumulator -= m_tickLength;
+        ++ticks;
+        ++m_tickCount;
+      }
+
+      // Drop time we could not simulate this frame, we would rather slow down
+      // than fall further behind
+      accumulator %= m_tickLength;
+
+      if (m_onRender)
+      {
+        m_onRender(static_cast<Float64>(accumulator) / m_tickLength);
+      }
+
+      ++m_frameCount;
+      m_redraw = false;
+      LSE_PROFILE_FRAME();
+
+      // Missed deadlines are not made up, the next frame starts from now
+      nextFrame += m_frameLength;
+      const Uint64 frameEnd = SDL_GetPerformanceCounter();
+      if (nextFrame <= frameEnd)
+      {
+        nextFrame = frameEnd;
+      }
+      else
+      {
+        wait_until(nextFrame);
+      }
+    }
+  }
+
+  void GameLoop::run_uncapped()
+  {
+    const Float64 tickSeconds = 1.0 / m_settings.tickRate;
+    const Uint64 pollInterval = 256;
+
+    while (!m_quit)
+    {
+      if (m_tickCount % pollInterval == 0)
+      {
+        poll_events();
+      }
+
+      if (m_onUpdate)
+      {
+        m_onUpdate(tickSeconds);
+      }
+
+      ++m_tickCount;
+    }
+  }
+
+  void GameLoop::run_threaded()
+  {
+    LSE_PROFILE_THREAD("Render");
+
+    std::thread simulation(&GameLoop::simulate, this);
+
+    Uint64 nextFrame = SDL_GetPerformanceCounter();
+
+    while (!m_quit)
+    {
+      if (!m_tickDone.exchange(false) && !m_redraw)
+      {
+        // Finished ticks push a wake event, so this sleeps until there is
+        // input or a new snapshot to draw
+        if (wait_for_events(m_settings.idleTimeoutMs))
+        {
+          wake_simulation();
+          m_redraw = true;
+        }
+
+        nextFrame = SDL_GetPerformanceCounter();
+        continue;
+      }
+
+      if (poll_events())
+      {
+        wake_simulation();
+      }
+
+      if (m_quit)
+      {
+        break;
+      }
+
+      if (m_onRender)
+      {
+        m_onRender(0.0);
+      }
+
+      ++m_frameCount;
+      m_redraw = false;
+      LSE_PROFILE_FRAME();
+
+      nextFrame += m_frameLength;
+      const Uint64 frameEnd = SDL_GetPerformanceCounter();
+      if (nextFrame <= frameEnd)
+      {
+        nextFrame = frameEnd;
+      }
+      else
+      {
+        wait_until(nextFrame);
+      }
+    }
+
+    simulation.join();
+  }
+
+  void GameLoop::simulate()
+  {
+    LSE_PROFILE_THREAD("Simulation");
+
+    const Float64 tickSeconds = 1.0 / m_settings.tickRate;
+
+    Uint64 nextTick = SDL_GetPerformanceCounter();
+
+    while (!m_quit)
+    {
+      if (!m_simulateOnce.exchange(false) && !is_animating())
+      {
+        // Nothing to simulate, sleep until the render thread has an event
+        // for us. The timeout rechecks is_animating.
+        std::unique_lock<std::mutex> lock(m_simulateMutex);
+        m_simulateWake.wait_for(lock, std::chrono::milliseconds(m_settings.idleTimeoutMs),
+          [this]() { return m_simulateOnce.load() || m_quit.load(); });
+        nextTick = SDL_GetPerformanceCounter();
+        continue;
+      }
+
+      if (m_onUpdate)
+      {
+        m_onUpdate(tickSeconds);
+      }
+
+      ++m_tickCount;
+      m_tickDone = true;
+      wake_events();
+
+      // A slow tick is not made up, the next one starts from now
+      nextTick += m_tickLength;
+      const Uint64 tickEnd = SDL_GetPerformanceCounter();
+      if (nextTick <= tickEnd)
+      {
+        nextTick = tickEnd;
+      }
+      else
+      {
+        wait_until(nextTick);
+      }
+    }
+  }
+
+  void GameLoop::wake_simulation()
+  {
+    {
+      std::lock_guard<std::mutex> lock(m_simulateMutex);
+      m_simulateOnce = true;
+    }
+
+    m_simulateWake.notify_one();
+  }
+
+  void GameLoop::wake_events()
+  {
+    // One queued wake event is enough to end a wait
+    if (m_wakeEvent != static_cast<Uint32>(-1) && !m_wakePending.exchange(true))
+    {
+      SDL_Event e;
+      SDL_zero(e);
+      e.type = m_wakeEvent;
+      if (SDL_PushEvent(&e) != 1)
+      {
+        m_wakePending = false;
+      }
+    }
+  }
+
+  bool GameLoop::handle_event(const SDL_Event& e)
+  {
+    if (e.type == m_wakeEvent)
+    {
+      m_wakePending = false;
+      return false;
+    }
+
+    if (m_onEvent)
+    {
+      m_onEvent(e);
+    }
+
+    return true;
+  }
+
+  bool GameLoop::poll_events()
+  {
+    LSE_PROFILE_ZONE("Poll Events");
+
+    bool handled = false;
+
+    SDL_Event e;
+    while (SDL_PollEvent(&e) != 0)
+    {
+      handled = handle_event(e) || handled;
+    }
+
+    return handled;
+  }
+
+  bool GameLoop::wait_for_events(UInt32 timeoutMs)
+  {
+    SDL_Event e;
+    if (SDL_WaitEventTimeout(&e, static_cast<int>(timeoutMs)) == 0)
+    {
+      return false;
+    }
+
+    const bool handled = handle_event(e);
+
+    // Drain anything else that arrived with it
+    return poll_events() || handled;
+  }
+
+  void GameLoop::wait_until(Uint64 deadline) const
+  {
+    const Uint64 spinLength = m_frequency * m_settings.spinThresholdMs / 1000;
+
+    for (;;)
+    {
+      const Uint64 now = SDL_GetPerformanceCounter();
+      if (now >= deadline)
+      {
+        return;
+      }
+
+      // Sleep through most of the wait and spin the last stretch so we do not
+      // overshoot the deadline
+      const Uint64 remaining = deadline - now;
+      if (remaining > spinLength)
+      {
+        SDL_Delay(static_cast<Uint32>((remaining - spinLength) * 1000 / m_frequency));
+      }
+    }
+  }
+}
@@ -0,0 +1,181 @@
+/******************************************************************************
+File: GameLoop.h
+Created: 10/17/2026 9:12:05 AM
+Copyright (c) 2017 Turn Tactics
+
+Permission is hereby granted, free of charge, to any person obtaining a copy
+of this software and associated documentation files (the "Software"), to deal
+in the Software without restriction, including without limitation the rights
+to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+copies of the Software, and to permit persons to whom the Software is
+furnished to do so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in
+all copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+SOFTWARE.
+
+Purpose: Contains the main loop scheduler that runs simulation ticks at a fixed
+         rate, paces rendered frames and sleeps when nothing is animating.
+
+Author: James Womack
+
+********************************************************************************/
+#pragma once
+
+#include "../Common.h"
+
+#include <SDL.h>
+#include <atomic>
+#include <condition_variable>
+#include <functional>
+#include <mutex>
+
+namespace lse
+{
+  // Settings that control how the game loop schedules ticks and frames
+  struct GameLoopSettings
+  {
+    // Number of fixed simulation ticks run per second
+    UInt32 tickRate = 60;
+
+    // Upper limit on rendered frames per second, 0 renders once per tick
+    UInt32 maxFrameRate = 60;
+
+    // Most ticks a single frame may run to catch up before time is dropped,
+    // this stops a long stall from spiraling into ever longer frames
+    UInt32 maxTicksPerFrame = 5;
+
+    // How long to block waiting on input when nothing is animating (ms)
+    UInt32 idleTimeoutMs = 250;
+
+    // Time before a frame deadline where sleeping stops and we spin (ms),
+    // SDL_Delay can oversleep by about a millisecond
+    UInt32 spinThresholdMs = 2;
+  };
+
+  // Runs the simulation at a fixed tick rate and renders with interpolation
+  // between ticks. Frames are paced to the frame rate cap with sleep-plus-spin
+  // waits and when nothing animates the loop blocks on the event queue instead
+  // of spinning.
+  class GameLoop
+  {
+  public:
+    // Called for every SDL event pulled off the queue
+    using EventCallback = std::function<void(const SDL_Event&)>;
+    // Called once per fixed tick with the tick length in seconds
+    using UpdateCallback = std::function<void(Float64)>;
+    // Called once per frame with how far (0-1) we are into the next tick
+    using RenderCallback = std::function<void(Float64)>;
+    // Returns if anything on screen is animating and needs ticks and frames
+    using AnimatingCallback = std::function<bool()>;
+
+    explicit GameLoop(GameLoopSettings settings = GameLoopSettings());
+
+    void on_event(EventCallback callback) { m_onEvent = std::move(callback); }
+    void on_update(UpdateCallback callback) { m_onUpdate = std::move(callback); }
+    void on_render(RenderCallback callback) { m_onRender = std::move(callback); }
+
+    // When no callback is given nothing is treated as animating and the loop
+    // only renders after events or redraw requests
+    void on_is_animating(AnimatingCallback callback) { m_isAnimating = std::move(callback); }
+
+    // Runs the loop until quit() is called
+    void run();
+
+    // Runs ticks back to back with no pacing, rendering or idle waits until
+    // quit() is called. Events are still polled every few hundred ticks so
+    // the process can be stopped.
+    void run_uncapped();
+
+    // Runs until quit() is called with the update callback on its own thread
+    // and events and rendering on the calling thread, which must be the one
+    // that created the window. A frame is rendered after every tick or
+    // event, the render callback gets 0 for alpha since the two threads do
+    // not share a clock and is expected to draw the latest snapshot the
+    // update callback published. The simulation thread sleeps while nothing
+    // is animating and runs a single tick after each event.
+    void run_threaded();
+
+    // Stops the loop after the current frame, safe from either thread
+    void quit();
+
+    // Forces a frame to be rendered even if the loop is idle
+    void request_redraw();
+
+    // The settings the loop was created with
+    const GameLoopSettings& settings() const { return m_settings; }
+
+    // Number of ticks run since the loop started
+    Uint64 tick_count() const { return m_tickCount.load(std::memory_order_relaxed); }
+
+    // Number of frames rendered since the loop started
+    Uint64 frame_count() const { return m_frameCount; }
+
+  private:
+    // Polls all pending events and hands them to the event callback,
+    // returns if any event was handled
+    bool poll_events();
+
+    // Blocks on the event queue until an event arrives or the timeout runs
+    // out, returns if an event was handled
+    bool wait_for_events(UInt32 timeoutMs);
+
+    // Hands an event to the event callback, returns false for the loop's
+    // own wake event which is never passed on
+    bool handle_event(const SDL_Event& e);
+
+    // Runs fixed ticks on the simulation thread for run_threaded()
+    void simulate();
+
+    // Has the simulation thread run a tick, waking it if it is idle
+    void wake_simulation();
+
+    // Wakes a thread blocked on the event queue
+    void wake_events();
+
+    // Sleeps then spins until the performance counter reaches the deadline
+    void wait_until(Uint64 deadline) const;
+
+    // Returns if anything is animating according to the callback
+    bool is_animating() const { return m_isAnimating && m_isAnimating(); }
+
+    GameLoopSettings m_settings;
+
+    EventCallback m_onEvent;
+    UpdateCallback m_onUpdate;
+    RenderCallback m_onRender;
+    AnimatingCallback m_isAnimating;
+
+    // Performance counter ticks per second and per simulation tick / frame
+    Uint64 m_frequency;
+    Uint64 m_tickLength;
+    Uint64 m_frameLength;
+
+    std::atomic<Uint64> m_tickCount;
+    Uint64 m_frameCount = 0;
+
+    std::atomic<bool> m_quit;
+    std::atomic<bool> m_redraw;
+
+    // Set for the simulation thread to run a tick even while idle and for
+    // the render thread when a tick has finished
+    std::atomic<bool> m_simulateOnce;
+    std::atomic<bool> m_tickDone;
+
+    // The idle simulation thread waits on this for m_simulateOnce or quit
+    std::mutex m_simulateMutex;
+    std::condition_variable m_simulateWake;
+
+    // SDL event type pushed to wake an idle wait on the event queue, and if
+    // one is already queued
+    Uint32 m_wakeEvent;
+    std::atomic<bool> m_wakePending;
+  };
+}
@@ -0,0 +1,200 @@
+/******************************************************************************
+File: JobSystem.cpp
+Created: 10/17/2026 5:05:12 PM
+Copyright (c) 2017 Turn Tactics
+
+Permission is hereby granted, free of charge, to any person obtaining a copy
+of this software and associated documentation files (the "Software"), to deal
+in the Software without restriction, including without limitation the rights
+to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+copies of the Software, and to permit persons to whom the Software is
+furnished to do so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in
+all copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+SOFTWARE.
+
+Purpose: Defines the job system, a fixed pool of worker threads that run small
+         jobs submitted by any engine system and steal work from each other
+         when their own queue runs dry.
+
+Author: James Womack
+
+********************************************************************************/
+#include "JobSystem.h"
+
+namespace lse
+{
+  namespace
+  {
+    // The job system and queue a worker thread belongs to, null for threads
+    // outside any pool
+    thread_local const JobSystem* t_jobSystem = nullptr;
+    thread_local UInt32 t_queueIndex = 0;
+  }
+
+  JobSystem::JobSystem(UInt32 workerCount) :
+    m_queued(0), m_running(true)
+  {
+    if (workerCount == 0)
+    {
+      const UInt32 hardwareThreads = std::thread::hardware_concurrency();
+      workerCount = hardwareThreads > 1 ? hardwareThreads - 1 : 1;
+    }
+
+    for (UInt32 i = 0; i <= workerCount; ++i)
+    {
+      m_queues.emplace_back(new Queue());
+    }
+
+    for (UInt32 i = 0; i < workerCount; ++i)
+    {
+      m_threads.emplace_back(&JobSystem::worker_main, this, i);
+    }
+  }
+
+  JobSystem::~JobSystem()
+  {
+    // Drain what is left so no counter is left waiting forever
+    while (run_one(current_queue()))
+    {
+    }
+
+    {
+      std::lock_guard<std::mutex> lock(m_sleepMutex);
+      m_running = false;
+    }
+    m_wake.notify_all();
+
+    for (std::thread& thread : m_threads)
+    {
+      thread.join();
+    }
+  }
+
+  void JobSystem::submit(Job job, JobCounter* counter)
+  {
+    if (counter != nullptr)
+    {
+      counter->m_pending.fetch_add(1, std::memory_order_relaxed);
+    }
+
+    Queue& queue = *m_queues[current_queue()];
+    {
+      std::lock_guard<std::mutex> lock(queue.mutex);
+      queue.tasks.push_back(Task{ std::move(job), counter });
+    }
+
+    m_queued.fetch_add(1, std::memory_order_release);
+
+    // Taking the lock orders this with a worker checking m_queued before it
+    // sleeps, without it the wake up could be missed
+    {
+      std::lock_guard<std::mutex> lock(m_sleepMutex);
+    }
+    m_wake.notify_one();
+  }
+
+  void JobSystem::wait(JobCounter& counter)
+  {
+    const UInt32 index = current_queue();
+
+    while (!counter.is_done())
+    {
+      if (!run_one(index))
+      {
+        std::this_thread::yield();
+      }
+    }
+  }
+
+  void JobSystem::worker_main(UInt32 index)
+  {
+    t_jobSystem = this;
+    t_queueIndex = index;
+
+    for (;;)
+    {
+      if (run_one(index))
+      {
+        continue;
+      }
+
+      std::unique_lock<std::mutex> lock(m_sleepMutex);
+      m_wake.wait(lock, [this]()
+      {
+        return !m_running || m_queued.load(std::memory_order_acquire) > 0;
+      });
+
+      if (!m_running && m_queued.load(std::memory_order_acquire) == 0)
+      {
+        return;
+      }
+    }
+  }
+
+  bool JobSystem::run_one(UInt32 index)
+  {
+    Task task;
+    bool found = false;
+
+    // Newest job from our own queue first, it is most likely still in cache
+    {
+      Queue& own = *m_queues[index];
+      std::lock_guard<std::mutex> lock(own.mutex);
+      if (!own.tasks.empty())
+      {
+        task = std::move(own.tasks.back());
+        own.tasks.pop_back();
+        found = true;
+      }
+    }
+
+    // Otherwise steal the oldest job from the next queue that has one
+    const UInt32 queueCount = static_cast<UInt32>(m_queues.size());
+    for (UInt32 offset = 1; !found && offset < queueCount; ++offset)
+    {
+      Queue& victim = *m_queues[(index + offset) % queueCount];
+      std::unique_lock<std::mutex> lock(victim.mutex, std::try_to_lock);
+      if (lock.owns_lock() && !victim.tasks.empty())
+      {
+        task = std::move(victim.tasks.front());
+        victim.tasks.pop_front();
+        found = true;
+      }
+    }
+
+    if (!found)
+    {
+      return false;
+    }
+
+    m_queued.fetch_sub(1, std::memory_order_relaxed);
+
+    task.job();
+
+    if (task.counter != nullptr)
+    {
+      task.counter->m_pending.fetch_sub(1, std::memory_order_release);
+    }
+
+    return true;
+  }
+
+  UInt32 JobSystem::current_queue() const
+  {
+    if (t_jobSystem == this)
+    {
+      return t_queueIndex;
+    }
+
+    return static_cast<UInt32>(m_queues.size() - 1);
+  }
+}
@@ -0,0 +1,154 @@
+/******************************************************************************
+File: JobSystem.h
+Created: 10/17/2026 5:05:12 PM
+Copyright (c) 2017 Turn Tactics
+
+Permission is hereby granted, free of charge, to any person obtaining a copy
+of this software and associated documentation files (the "Software"), to deal
+in the Software without restriction, including without limitation the rights
+to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+copies of the Software, and to permit persons to whom the Software is
+furnished to do so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in
+all copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+SOFTWARE.
+
+Purpose: Defines the job system, a fixed pool of worker threads that run small
+         jobs submitted by any engine system and steal work from each other
+         when their own queue runs dry.
+
+Author: James Womack
+
+********************************************************************************/
+#pragma once
+
+#include "../Common.h"
+
+#include <atomic>
+#include <condition_variable>
+#include <deque>
+#include <functional>
+#include <memory>
+#include <mutex>
+#include <thread>
+
+namespace lse
+{
+  // Counts the jobs of a group that have not finished yet. A parent hands
+  // the same counter to each child it submits and then waits on it.
+  class JobCounter
+  {
+  public:
+    JobCounter() : m_pending(0) {}
+
+    JobCounter(const JobCounter&) = delete;
+    JobCounter& operator=(const JobCounter&) = delete;
+
+    // Returns if every job counted has finished
+    bool is_done() const { return m_pending.load(std::memory_order_acquire) == 0; }
+
+  private:
+    friend class JobSystem;
+    std::atomic<UInt32> m_pending;
+  };
+
+  // A fixed pool of worker threads with one job deque per worker. Workers
+  // push and pop their own jobs from the back and steal from the front of
+  // other deques when theirs is empty. Jobs submitted from outside the pool
+  // go to a shared deque that every worker steals from.
+  class JobSystem
+  {
+  public:
+    using Job = std::function<void()>;
+
+    // Starts the workers, 0 uses one worker per hardware thread minus the
+    // one the caller runs on
+    explicit JobSystem(UInt32 workerCount = 0);
+
+    // Finishes queued jobs and joins the workers
+    ~JobSystem();
+
+    JobSystem(const JobSystem&) = delete;
+    JobSystem& operator=(const JobSystem&) = delete;
+
+    // Queues a job, the counter (if given) is decremented when it finishes
+    void submit(Job job, JobCounter* counter = nullptr);
+
+    // Runs queued jobs on the calling thread until the counter reaches zero
+    void wait(JobCounter& counter);
+
+    // Calls body(i) for every i in [begin, end) spread over the workers in
+    // chunks of grainSize indices and returns once all are done
+    template<class TBody>
+    void parallel_for(UInt32 begin, UInt32 end, UInt32 grainSize, const TBody& body)
+    {
+      if (begin >= end)
+      {
+        return;
+      }
+
+      grainSize = std::max<UInt32>(grainSize, 1);
+
+      JobCounter counter;
+      for (UInt32 first = begin; first < end; first += std::min(grainSize, end - first))
+      {
+        const UInt32 last = first + std::min(grainSize, end - first);
+        submit([first, last, &body]()
+        {
+          for (UInt32 i = first; i < last; ++i)
+          {
+            body(i);
+          }
+        }, &counter);
+      }
+
+      wait(counter);
+    }
+
+    // Number of worker threads in the pool
+    UInt32 worker_count() const { return static_cast<UInt32>(m_threads.size()); }
+
+  private:
+    struct Task
+    {
+      Job job;
+      JobCounter* counter;
+    };
+
+    // A worker's queue, each is allocated on its own
+    struct Queue
+    {
+      std::mutex mutex;
+      std::deque<Task> tasks;
+    };
+
+    // Main loop of each worker thread
+    void worker_main(UInt32 index);
+
+    // Pops a job from the given queue or steals one from another queue and
+    // runs it, returns false if every queue was empty
+    bool run_one(UInt32 index);
+
+    // Returns the queue index owned by the calling thread
+    UInt32 current_queue() const;
+
+    // One queue per worker plus the shared queue for outside threads, which
+    // is always the last one
+    containers::Vector<std::unique_ptr<Queue>> m_queues;
+    containers::Vector<std::thread> m_threads;
+
+    // Jobs queued but not yet taken, workers sleep while this is zero
+    std::atomic<UInt32> m_queued;
+    std::atomic<bool> m_running;
+    std::mutex m_sleepMutex;
+    std::condition_variable m_wake;
+  };
+}
@@ -0,0 +1,178 @@
+/******************************************************************************
+File: LogDecoder.cpp
+Created: 10/22/2026 6:41:27 PM
+Copyright (c) 2017 Turn Tactics
+
+Permission is hereby granted, free of charge, to any person obtaining a copy
+of this software and associated documentation files (the "Software"), to deal
+in the Software without restriction, including without limitation the rights
+to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+copies of the Software, and to permit persons to whom the Software is
+furnished to do so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in
+all copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+SOFTWARE.
+
+Purpose: Turns binary logs written by the logger back into text, used by the
+         --decode-log command line tool.
+
+Author: James Womack
+
+********************************************************************************/
+#include "Logger.h"
+
+#include <fstream>
+#include <iterator>
+#include <stdio.h>
+
+namespace lse
+{
+  namespace logger
+  {
+    namespace
+    {
+      // Reads values from a whole log file held in memory
+      class Reader
+      {
+      public:
+        Reader(const String& data) : m_cursor(data.data()), m_end(data.data() + data.size()) {}
+
+        template<class T>
+        bool read(T& value)
+        {
+          if (static_cast<size_t>(m_end - m_cursor) < sizeof(T))
+          {
+            return false;
+          }
+
+          std::memcpy(&value, m_cursor, sizeof(T));
+          m_cursor += sizeof(T);
+          return true;
+        }
+
+        const char* take(size_t bytes)
+        {
+          if (static_cast<size_t>(m_end - m_cursor) < bytes)
+          {
+            return nullptr;
+          }
+
+          const char* data = m_cursor;
+          m_cursor += bytes;
+          return data;
+        }
+
+        bool done() const { return m_cursor == m_end; }
+
+      private:
+        const char* m_cursor;
+        const char* m_end;
+      };
+    }
+
+    bool decode(const String& path, std::ostream& out)
+    {
+      std::ifstream file(path, std::ios::in | std::ios::binary);
+      if (!file.is_open())
+      {
+        printf("Unable to open log file %s!\n", path.c_str());
+        return false;
+      }
+
+      const String data((std::istreambuf_iterator<char>(file)), std::istreambuf_iterator<char>());
+      Reader reader(data);
+
+      const char* magic = reader.take(sizeof(binary::Magic));
+      UInt32 version = 0;
+      Uint64 frequency = 0;
+      Uint64 origin = 0;
+      if (magic == nullptr || std::memcmp(magic, binary::Magic, sizeof(binary::Magic)) != 0 ||
+        !reader.read(version) || !reader.read(frequency) || !reader.read(origin))
+      {
+        printf("%s is not a binary log!\n", path.c_str());
+        return false;
+      }
+
+      if (version != binary::Version || frequency == 0)
+      {
+        printf("%s has unsupported log version %u!\n", path.c_str(), version);
+        return false;
+      }
+
+      containers::UnorderedMap<FormatId, String> formats;
+      String line;
+      while (!reader.done())
+      {
+        UInt8 type = 0;
+        reader.read(type);
+
+        bool valid = false;
+        switch (static_cast<binary::ChunkType>(type))
+        {
+        case binary::ChunkType::Format:
+        {
+          FormatId id = 0;
+          UInt16 length = 0;
+          const char* format = nullptr;
+          valid = reader.read(id) && reader.read(length) && (format = reader.take(length)) != nullptr;
+          if (valid)
+          {
+            formats[id] = String(format, length);
+          }
+          break;
+        }
+        case binary::ChunkType::Message:
+        {
+          Uint64 time = 0;
+          UInt32 thread = 0;
+          LogLevel level = LogLevel::Info;
+          LogCategory category = LogCategory::General;
+          FormatId id = 0;
+          UInt16 size = 0;
+          const char* payload = nullptr;
+          valid = reader.read(time) && reader.read(thread) && reader.read(level) && reader.read(category) && reader.read(id) &&
+            reader.read(size) && (payload = reader.take(size)) != nullptr;
+          if (valid)
+          {
+            const auto format = formats.find(id);
+            const Float64 seconds = static_cast<Float64>(time - origin) / frequency;
+            line.clear();
+            format_line(line, seconds, level, category, thread, format != formats.end() ? format->second.c_str() : "%s",
+              reinterpret_cast<const UInt8*>(payload), size);
+            out.write(line.data(), static_cast<std::streamsize>(line.size()));
+          }
+          break;
+        }
+        case binary::ChunkType::Dropped:
+        {
+          UInt32 count = 0;
+          valid = reader.read(count);
+          if (valid)
+          {
+            out << "Logger queue was full, dropped " << count << " messages\n";
+          }
+          break;
+        }
+        }
+
+        if (!valid)
+        {
+          // A crash can leave the last chunk half written
+          printf("%s ends with a damaged chunk, stopping there\n", path.c_str());
+          break;
+        }
+      }
+
+      out.flush();
+      return true;
+    }
+  }
+}
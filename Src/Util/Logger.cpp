@@ -0,0 +1,816 @@
+/******************************************************************************
+File: Logger.cpp
+Created: 10/22/2026 2:14:03 PM
+Copyright (c) 2017 Turn Tactics
+
+Permission is hereby granted, free of charge, to any person obtaining a copy
+of this software and associated documentation files (the "Software"), to deal
+in the Software without restriction, including without limitation the rights
+to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+copies of the Software, and to permit persons to whom the Software is
+furnished to do so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in
+all copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+SOFTWARE.
+
+Purpose: Contains an advanced logger that can log runtime data to a file and
+         tune how much data is recorded.
+
+Author: James Womack
+
+********************************************************************************/
+#include "Logger.h"
+#include "CrashLogRing.h"
+#include "MpscQueue.h"
+
+#include <algorithm>
+#include <atomic>
+#include <chrono>
+#include <condition_variable>
+#include <fstream>
+#include <memory>
+#include <mutex>
+#include <stdio.h>
+#include <thread>
+
+namespace lse
+{
+  namespace logger
+  {
+    namespace
+    {
+      // Format strings that can be registered
+      const UInt32 MaxFormats = 16384;
+
+      // Format used by write, the message is formatted up front and logged
+      // as a single string
+      const FormatId TextFormat = 0;
+
+      // A message waiting in the queue. Only the format ID and the raw
+      // arguments are copied, the text is built by the writer thread.
+      struct Record
+      {
+        Uint64 time;
+        SDL_threadID thread;
+        FormatId format;
+        LogLevel level;
+        LogCategory category;
+        UInt16 size;
+        UInt8 payload[MaxPayloadSize];
+      };
+
+      // Registered format strings. Read without locking by the writer, the
+      // count is published after the string.
+      struct FormatTable
+      {
+        std::mutex mutex;
+        std::atomic<UInt32> count{ 1 };
+        std::atomic<const char*> formats[MaxFormats] = {};
+
+        FormatTable()
+        {
+          formats[TextFormat].store("%s");
+        }
+      };
+
+      struct State
+      {
+        LoggerSettings settings;
+        std::unique_ptr<MpscQueue<Record>> queue;
+        std::ofstream file;
+        std::thread writer;
+        std::atomic<bool> running{ false };
+        Uint64 origin = 0;
+        Uint64 frequency = 1;
+        std::atomic<Uint64> dropped{ 0 };
+        CrashLogRing ring;
+
+        // Wakes the writer early for a flush or stop
+        std::mutex mutex;
+        std::condition_variable wake;
+        std::condition_variable written;
+        bool quit = false;
+        bool flushRequested = false;
+        size_t writtenCount = 0;
+      };
+
+      State& state()
+      {
+        static State s_state;
+        return s_state;
+      }
+
+      FormatTable& format_table()
+      {
+        static FormatTable s_table;
+        return s_table;
+      }
+
+      const char* format_string(FormatId id)
+      {
+        FormatTable& table = format_table();
+        return id < table.count.load(std::memory_order_acquire) ? table.formats[id].load(std::memory_order_relaxed) : "%s";
+      }
+
+      template<class T>
+      void append_value(String& out, const T& value)
+      {
+        out.append(reinterpret_cast<const char*>(&value), sizeof(T));
+      }
+
+      template<class T>
+      bool read_value(const UInt8*& cursor, const UInt8* end, T& value)
+      {
+        if (static_cast<size_t>(end - cursor) < sizeof(T))
+        {
+          return false;
+        }
+
+        std::memcpy(&value, cursor, sizeof(T));
+        cursor += sizeof(T);
+        return true;
+      }
+
+      // One decoded argument, held as every type it can be printed as
+      struct Arg
+      {
+        ArgType type;
+        Sint64 i = 0;
+        Uint64 u = 0;
+        Float64 f = 0.0;
+        const char* str = nullptr;
+        UInt16 length = 0;
+      };
+
+      bool read_arg(const UInt8*& cursor, const UInt8* end, Arg& arg)
+      {
+        if (cursor >= end)
+        {
+          return false;
+        }
+
+        arg.type = static_cast<ArgType>(*cursor++);
+        switch (arg.type)
+        {
+        case ArgType::Int32:
+        {
+          Int32 value;
+          if (!read_value(cursor, end, value)) return false;
+          arg.i = value;
+          arg.u = static_cast<Uint64>(arg.i);
+          arg.f = value;
+          return true;
+        }
+        case ArgType::Int64:
+          if (!read_value(cursor, end, arg.i)) return false;
+          arg.u = static_cast<Uint64>(arg.i);
+          arg.f = static_cast<Float64>(arg.i);
+          return true;
+        case ArgType::UInt32:
+        {
+          UInt32 value;
+          if (!read_value(cursor, end, value)) return false;
+          arg.u = value;
+          arg.i = value;
+          arg.f = value;
+          return true;
+        }
+        case ArgType::UInt64:
+        case ArgType::Pointer:
+          if (!read_value(cursor, end, arg.u)) return false;
+          arg.i = static_cast<Sint64>(arg.u);
+          arg.f = static_cast<Float64>(arg.u);
+          return true;
+        case ArgType::Float64:
+          if (!read_value(cursor, end, arg.f)) return false;
+          arg.i = static_cast<Sint64>(arg.f);
+          arg.u = static_cast<Uint64>(arg.i);
+          return true;
+        case ArgType::String:
+          if (!read_value(cursor, end, arg.length) || static_cast<size_t>(end - cursor) < arg.length) return false;
+          arg.str = reinterpret_cast<const char*>(cursor);
+          cursor += arg.length;
+          return true;
+        }
+
+        return false;
+      }
+
+      // Appends an argument that does not match its conversion as it was
+      // recorded rather than reinterpreting the bytes
+      void append_arg(String& out, const Arg& arg)
+      {
+        char text[64];
+        int length = 0;
+        switch (arg.type)
+        {
+        case ArgType::Int32:
+        case ArgType::Int64:
+          length = snprintf(text, sizeof(text), "%lld", static_cast<long long>(arg.i));
+          break;
+        case ArgType::UInt32:
+        case ArgType::UInt64:
+          length = snprintf(text, sizeof(text), "%llu", static_cast<unsigned long long>(arg.u));
+          break;
+        case ArgType::Pointer:
+          length = snprintf(text, sizeof(text), "0x%llx", static_cast<unsigned long long>(arg.u));
+          break;
+        case ArgType::Float64:
+          length = snprintf(text, sizeof(text), "%g", arg.f);
+          break;
+        case ArgType::String:
+          out.append(arg.str, arg.length);
+          return;
+        }
+
+        out.append(text, static_cast<size_t>(std::max(length, 0)));
+      }
+
+      // Writes the messages in a batch to the file, and the console if asked
+      void write_batch(String& batch)
+      {
+        State& st = state();
+        if (batch.empty())
+        {
+          return;
+        }
+
+        st.file.write(batch.data(), static_cast<std::streamsize>(batch.size()));
+        st.file.flush();
+
+        if (st.settings.echoToConsole && !st.settings.binary)
+        {
+          fwrite(batch.data(), 1, batch.size(), stdout);
+          fflush(stdout);
+        }
+
+        batch.clear();
+      }
+
+      void writer_main()
+      {
+        State& st = state();
+        const bool binary = st.settings.binary;
+        String batch;
+        batch.reserve(64 * 1024);
+        Uint64 reportedDrops = 0;
+
+        // Formats already written to this file
+        std::vector<bool> formatsWritten(MaxFormats, false);
+
+        if (binary)
+        {
+          batch.append(binary::Magic, sizeof(binary::Magic));
+          append_value(batch, binary::Version);
+          append_value(batch, st.frequency);
+          append_value(batch, st.origin);
+        }
+
+        const auto add_record = [&](Record& record)
+        {
+          if (!binary)
+          {
+            const Float64 seconds = static_cast<Float64>(record.time - st.origin) / st.frequency;
+            format_line(batch, seconds, record.level, record.category, static_cast<UInt32>(record.thread),
+              format_string(record.format), record.payload, record.size);
+            return;
+          }
+
+          if (!formatsWritten[record.format])
+          {
+            const char* format = format_string(record.format);
+            const UInt16 length = static_cast<UInt16>(std::min<size_t>(std::strlen(format), 0xFFFF));
+            batch.push_back(static_cast<char>(binary::ChunkType::Format));
+            append_value(batch, record.format);
+            append_value(batch, length);
+            batch.append(format, length);
+            formatsWritten[record.format] = true;
+          }
+
+          batch.push_back(static_cast<char>(binary::ChunkType::Message));
+          append_value(batch, record.time);
+          append_value(batch, static_cast<UInt32>(record.thread));
+          append_value(batch, record.level);
+          append_value(batch, record.category);
+          append_value(batch, record.format);
+          append_value(batch, record.size);
+          batch.append(reinterpret_cast<const char*>(record.payload), record.size);
+        };
+
+        for (;;)
+        {
+          bool quit;
+          {
+            std::lock_guard<std::mutex> lock(st.mutex);
+            quit = st.quit;
+            st.flushRequested = false;
+          }
+
+          // Take everything that is ready in one batch
+          while (st.queue->try_pop(add_record))
+          {
+          }
+
+          const Uint64 dropped = st.dropped.load(std::memory_order_relaxed);
+          if (dropped != reportedDrops)
+          {
+            const UInt32 count = static_cast<UInt32>(dropped - reportedDrops);
+            if (binary)
+            {
+              batch.push_back(static_cast<char>(binary::ChunkType::Dropped));
+              append_value(batch, count);
+            }
+            else
+            {
+              char line[96];
+              const int length = snprintf(line, sizeof(line), "Logger queue was full, dropped %u messages\n", count);
+              batch.append(line, static_cast<size_t>(std::max(length, 0)));
+            }
+
+            reportedDrops = dropped;
+          }
+
+          write_batch(batch);
+
+          std::unique_lock<std::mutex> lock(st.mutex);
+          st.writtenCount = st.queue->popped_count();
+          st.written.notify_all();
+
+          if (quit)
+          {
+            return;
+          }
+
+          st.wake.wait_for(lock, std::chrono::milliseconds(st.settings.flushIntervalMs),
+            [&st]() { return st.quit || st.flushRequested; });
+        }
+      }
+    }
+
+    namespace detail
+    {
+      std::atomic<UInt8> categoryLevels[to_integral(LogCategory::Count)] = {};
+    }
+
+    void set_category_level(LogCategory category, LogLevel level)
+    {
+      detail::categoryLevels[to_integral(category)].store(to_integral(level), std::memory_order_relaxed);
+    }
+
+    LogLevel category_level(LogCategory category)
+    {
+      return static_cast<LogLevel>(detail::categoryLevels[to_integral(category)].load(std::memory_order_relaxed));
+    }
+
+    void set_level(LogLevel level)
+    {
+      for (UInt8 category = 0; category < to_integral(LogCategory::Count); ++category)
+      {
+        set_category_level(static_cast<LogCategory>(category), level);
+      }
+    }
+
+    const char* category_name(LogCategory category)
+    {
+      switch (category)
+      {
+      case LogCategory::General: return "General";
+      case LogCategory::Render: return "Render";
+      case LogCategory::Input: return "Input";
+      case LogCategory::Net: return "Net";
+      case LogCategory::AI: return "AI";
+      case LogCategory::Audio: return "Audio";
+      case LogCategory::Count: break;
+      }
+
+      return "Unknown";
+    }
+
+    bool parse_level(const char* name, LogLevel& level)
+    {
+      for (UInt8 value = 0; value <= to_integral(LogLevel::Off); ++value)
+      {
+        if (SDL_strcasecmp(name, level_name(static_cast<LogLevel>(value))) == 0)
+        {
+          level = static_cast<LogLevel>(value);
+          return true;
+        }
+      }
+
+      return false;
+    }
+
+    bool parse_category(const char* name, LogCategory& category)
+    {
+      for (UInt8 value = 0; value < to_integral(LogCategory::Count); ++value)
+      {
+        if (SDL_strcasecmp(name, category_name(static_cast<LogCategory>(value))) == 0)
+        {
+          category = static_cast<LogCategory>(value);
+          return true;
+        }
+      }
+
+      return false;
+    }
+
+    bool start(const LoggerSettings& settings)
+    {
+      State& st = state();
+      if (st.running.load())
+      {
+        stop();
+      }
+
+      st.file.open(settings.path, std::ios::out | std::ios::trunc | std::ios::binary);
+      if (!st.file.is_open())
+      {
+        printf("Unable to open log file %s!\n", settings.path.c_str());
+        return false;
+      }
+
+      st.settings = settings;
+      st.queue.reset(new MpscQueue<Record>(settings.queueCapacity));
+      st.origin = SDL_GetPerformanceCounter();
+      st.frequency = SDL_GetPerformanceFrequency();
+
+      // The ring needs every format registered so far, later ones are
+      // added as they are registered
+      if (!settings.crashRingPath.empty() &&
+        st.ring.open(settings.crashRingPath, settings.crashRingSlots, st.frequency, st.origin))
+      {
+        FormatTable& table = format_table();
+        std::lock_guard<std::mutex> lock(table.mutex);
+        for (FormatId id = 0; id < table.count.load(std::memory_order_relaxed); ++id)
+        {
+          st.ring.add_format(id, table.formats[id].load(std::memory_order_relaxed));
+        }
+      }
+
+      st.dropped.store(0);
+      st.quit = false;
+      st.flushRequested = false;
+      st.writtenCount = 0;
+      st.writer = std::thread(writer_main);
+      st.running.store(true, std::memory_order_release);
+      return true;
+    }
+
+    void stop()
+    {
+      State& st = state();
+      if (!st.running.load())
+      {
+        return;
+      }
+
+      st.running.store(false, std::memory_order_release);
+      {
+        std::lock_guard<std::mutex> lock(st.mutex);
+        st.quit = true;
+      }
+      st.wake.notify_one();
+      st.writer.join();
+      st.file.close();
+      st.ring.close();
+    }
+
+    bool is_running()
+    {
+      return state().running.load(std::memory_order_acquire);
+    }
+
+    FormatId register_format(const char* format)
+    {
+      FormatTable& table = format_table();
+      std::lock_guard<std::mutex> lock(table.mutex);
+
+      const UInt32 id = table.count.load(std::memory_order_relaxed);
+      if (id == MaxFormats)
+      {
+        // Out of IDs, the arguments are still printed one after another
+        return TextFormat;
+      }
+
+      table.formats[id].store(format, std::memory_order_relaxed);
+      table.count.store(id + 1, std::memory_order_release);
+
+      State& st = state();
+      if (st.running.load(std::memory_order_acquire) && st.ring.is_open())
+      {
+        st.ring.add_format(id, format);
+      }
+      return id;
+    }
+
+    void write_encoded(LogLevel level, LogCategory category, FormatId format, const UInt8* payload, UInt32 size)
+    {
+      State& st = state();
+      if (!st.running.load(std::memory_order_acquire))
+      {
+        // Not started yet or already stopped, print straight away
+        String text;
+        format_message(format_string(format), payload, size, text);
+        printf("%-7s %s\n", level_name(level), text.c_str());
+        return;
+      }
+
+      const Uint64 time = SDL_GetPerformanceCounter();
+      const SDL_threadID thread = SDL_ThreadID();
+      if (st.ring.is_open())
+      {
+        st.ring.write(time, static_cast<UInt32>(thread), level, category, format, payload, size);
+      }
+
+      const bool pushed = st.queue->try_push([&](Record& record)
+      {
+        record.time = time;
+        record.thread = thread;
+        record.format = format;
+        record.level = level;
+        record.category = category;
+        record.size = static_cast<UInt16>(size);
+        std::memcpy(record.payload, payload, size);
+      });
+
+      if (!pushed)
+      {
+        st.dropped.fetch_add(1, std::memory_order_relaxed);
+      }
+
+      if (level == LogLevel::Fatal)
+      {
+        flush();
+      }
+    }
+
+    void write(LogLevel level, LogCategory category, const char* format, ...)
+    {
+      va_list args;
+      va_start(args, format);
+      write_args(level, category, format, args);
+      va_end(args);
+    }
+
+    void write_args(LogLevel level, LogCategory category, const char* format, va_list args)
+    {
+      if (!is_enabled(level, category))
+      {
+        return;
+      }
+
+      // Leave room for the string's type and length
+      char text[MaxPayloadSize - 3];
+      const int length = vsnprintf(text, sizeof(text), format, args);
+
+      UInt8 payload[MaxPayloadSize];
+      ArgEncoder encoder(payload, MaxPayloadSize);
+      encoder.add(String(text, std::min(static_cast<size_t>(std::max(length, 0)), sizeof(text) - 1)));
+      write_encoded(level, category, TextFormat, payload, encoder.size());
+    }
+
+    void flush()
+    {
+      State& st = state();
+      if (!st.running.load(std::memory_order_acquire))
+      {
+        return;
+      }
+
+      const size_t target = st.queue->pushed_count();
+
+      std::unique_lock<std::mutex> lock(st.mutex);
+      st.flushRequested = true;
+      st.wake.notify_one();
+      st.written.wait(lock, [&st, target]()
+      {
+        if (st.writtenCount < target)
+        {
+          // A message may still be being written, keep the writer awake
+          st.flushRequested = true;
+          st.wake.notify_one();
+          return false;
+        }
+
+        return true;
+      });
+    }
+
+    Uint64 dropped_count()
+    {
+      return state().dropped.load(std::memory_order_relaxed);
+    }
+
+    const char* level_name(LogLevel level)
+    {
+      switch (level)
+      {
+      case LogLevel::Trace: return "TRACE";
+      case LogLevel::Debug: return "DEBUG";
+      case LogLevel::Info: return "INFO";
+      case LogLevel::Warning: return "WARNING";
+      case LogLevel::Error: return "ERROR";
+      case LogLevel::Fatal: return "FATAL";
+      case LogLevel::Off: return "OFF";
+      }
+
+      return "UNKNOWN";
+    }
+
+    void format_message(const char* format, const UInt8* payload, UInt32 size, String& out)
+    {
+      const UInt8* cursor = payload;
+      const UInt8* end = payload + size;
+
+      const char* c = format;
+      while (*c != '\0')
+      {
+        if (*c != '%')
+        {
+          out.push_back(*c++);
+          continue;
+        }
+
+        if (c[1] == '%')
+        {
+          out.push_back('%');
+          c += 2;
+          continue;
+        }
+
+        // Rebuild the conversion without its length modifier, the argument
+        // is always passed as a 64 bit value. Room is kept for "ll", the
+        // conversion and the terminator, formats come from log files so a
+        // conversion too long to fit is printed as it is.
+        const char* specStart = c;
+        char spec[32];
+        const size_t specLimit = sizeof(spec) - 4;
+        size_t specLength = 0;
+        bool specTooLong = false;
+
+        const auto push_spec = [&](const char* chars, size_t count)
+        {
+          if (count > specLimit - specLength)
+          {
+            specTooLong = true;
+            return;
+          }
+
+          std::memcpy(spec + specLength, chars, count);
+          specLength += count;
+        };
+
+        const auto copy_spec = [&](const char* chars)
+        {
+          while (*c != '\0' && std::strchr(chars, *c) != nullptr)
+          {
+            push_spec(c++, 1);
+          }
+        };
+
+        // Star widths and precisions take the next argument
+        const auto copy_star = [&]()
+        {
+          Arg arg;
+          ++c;
+          if (read_arg(cursor, end, arg))
+          {
+            char number[16];
+            const int length = snprintf(number, sizeof(number), "%d", static_cast<int>(arg.i));
+            push_spec(number, std::min(static_cast<size_t>(std::max(length, 0)), sizeof(number) - 1));
+          }
+        };
+
+        push_spec(c++, 1);
+        copy_spec("-+ #0");
+        *c == '*' ? copy_star() : copy_spec("0123456789");
+        if (*c == '.')
+        {
+          push_spec(c++, 1);
+          *c == '*' ? copy_star() : copy_spec("0123456789");
+        }
+
+        while (*c != '\0' && std::strchr("hljztL", *c) != nullptr)
+        {
+          ++c;
+        }
+
+        const char conversion = *c;
+        if (conversion == '\0')
+        {
+          out.append(specStart, static_cast<size_t>(c - specStart));
+          break;
+        }
+        ++c;
+
+        Arg arg;
+        if (!read_arg(cursor, end, arg))
+        {
+          out.append("(missing)");
+          continue;
+        }
+
+        if (specTooLong)
+        {
+          out.append(specStart, static_cast<size_t>(c - specStart));
+          continue;
+        }
+
+        char text[512];
+        int length = -1;
+        switch (conversion)
+        {
+        case 'd':
+        case 'i':
+        case 'u':
+        case 'o':
+        case 'x':
+        case 'X':
+          if (arg.type == ArgType::String)
+          {
+            break;
+          }
+
+          spec[specLength++] = 'l';
+          spec[specLength++] = 'l';
+          spec[specLength++] = conversion;
+          spec[specLength] = '\0';
+          length = conversion == 'd' || conversion == 'i'
+            ? snprintf(text, sizeof(text), spec, static_cast<long long>(arg.i))
+            : snprintf(text, sizeof(text), spec, static_cast<unsigned long long>(arg.u));
+          break;
+        case 'f':
+        case 'F':
+        case 'e':
+        case 'E':
+        case 'g':
+        case 'G':
+        case 'a':
+        case 'A':
+          if (arg.type == ArgType::String)
+          {
+            break;
+          }
+
+          spec[specLength++] = conversion;
+          spec[specLength] = '\0';
+          length = snprintf(text, sizeof(text), spec, arg.f);
+          break;
+        case 'c':
+          if (arg.type == ArgType::String)
+          {
+            break;
+          }
+
+          spec[specLength++] = conversion;
+          spec[specLength] = '\0';
+          length = snprintf(text, sizeof(text), spec, static_cast<int>(arg.i));
+          break;
+        case 's':
+          if (arg.type != ArgType::String)
+          {
+            break;
+          }
+
+          spec[specLength++] = conversion;
+          spec[specLength] = '\0';
+          length = snprintf(text, sizeof(text), spec, String(arg.str, arg.length).c_str());
+          break;
+        case 'p':
+          spec[specLength++] = conversion;
+          spec[specLength] = '\0';
+          length = snprintf(text, sizeof(text), spec, reinterpret_cast<void*>(static_cast<std::uintptr_t>(arg.u)));
+          break;
+        }
+
+        if (length < 0)
+        {
+          append_arg(out, arg);
+        }
+        else
+        {
+          out.append(text, std::min(static_cast<size_t>(length), sizeof(text) - 1));
+        }
+      }
+    }
+
+    void format_line(String& out, Float64 seconds, LogLevel level, LogCategory category, UInt32 thread, const char* format,
+      const UInt8* payload, UInt32 size)
+    {
+      char prefix[80];
+      const int length = snprintf(prefix, sizeof(prefix), "[%11.4f] %-7s %-7s [%u] ", seconds, level_name(level),
+        category_name(category), thread);
+      out.append(prefix, static_cast<size_t>(std::max(length, 0)));
+      format_message(format, payload, size, out);
+      out.push_back('\n');
+    }
+  }
+}
@@ -30,3 +30,373 @@ Author: James Womack
 #pragma once
 
 #include "../Common.h"
+
+#include <SDL.h>
+#include <algorithm>
+#include <atomic>
+#include <cstdint>
+#include <cstring>
+#include <ostream>
+#include <stdarg.h>
+#include <type_traits>
+
+// Messages below this level are compiled out, their arguments are never
+// evaluated. Debug builds keep everything, release builds keep Info and up.
+// Define LSE_LOG_MIN_LEVEL as one of the levels below to override it.
+#define LSE_LOG_LEVEL_TRACE 0
+#define LSE_LOG_LEVEL_DEBUG 1
+#define LSE_LOG_LEVEL_INFO 2
+#define LSE_LOG_LEVEL_WARNING 3
+#define LSE_LOG_LEVEL_ERROR 4
+#define LSE_LOG_LEVEL_FATAL 5
+#define LSE_LOG_LEVEL_OFF 6
+
+#ifndef LSE_LOG_MIN_LEVEL
+#ifdef NDEBUG
+#define LSE_LOG_MIN_LEVEL LSE_LOG_LEVEL_INFO
+#else
+#define LSE_LOG_MIN_LEVEL LSE_LOG_LEVEL_TRACE
+#endif
+#endif
+
+namespace lse
+{
+  // How serious a log message is
+  enum class LogLevel : UInt8
+  {
+    Trace,
+    Debug,
+    Info,
+    Warning,
+    Error,
+    Fatal,
+
+    // Only used as a filter, turns a category off
+    Off
+  };
+
+  // Engine system a message comes from, each can be filtered at runtime
+  enum class LogCategory : UInt8
+  {
+    General,
+    Render,
+    Input,
+    Net,
+    AI,
+    Audio,
+    Count
+  };
+
+  struct LoggerSettings
+  {
+    // File the log is written to, truncated on start
+    String path = "game.log";
+
+    // Write compact binary records instead of text. Nothing is formatted
+    // until the file is decoded with --decode-log, which makes logging
+    // cheaper and the file several times smaller.
+    bool binary = false;
+
+    // Also print every message to stdout, text mode only
+    bool echoToConsole = true;
+
+    // Messages that can wait to be written, must be a power of two. When it
+    // fills up new messages are dropped and counted rather than blocking.
+    UInt32 queueCapacity = 8192;
+
+    // Longest the writer thread sleeps before checking for messages
+    UInt32 flushIntervalMs = 10;
+
+    // Memory mapped file the most recent messages are also copied into,
+    // empty for none. It survives the game crashing with messages still
+    // queued, read it back with --recover-log.
+    String crashRingPath;
+
+    // Messages the crash ring keeps, 256 bytes each
+    UInt32 crashRingSlots = 4096;
+  };
+
+  namespace logger
+  {
+    // Identifies a registered format string
+    using FormatId = UInt32;
+
+    // Bytes of encoded arguments kept per message, arguments that do not fit
+    // are dropped and strings are cut short
+    const UInt32 MaxPayloadSize = 224;
+
+    // Type written before each encoded argument
+    enum class ArgType : UInt8
+    {
+      Int32,
+      Int64,
+      UInt32,
+      UInt64,
+      Float64,
+      String,
+      Pointer
+    };
+
+    // Records the raw bytes of log arguments so formatting can wait until the
+    // message is written or decoded
+    class ArgEncoder
+    {
+    public:
+      ArgEncoder(UInt8* buffer, UInt32 capacity) : m_buffer(buffer), m_capacity(capacity), m_size(0) {}
+
+      template<class T>
+      void add(const T& value)
+      {
+        if constexpr (std::is_same<T, bool>::value)
+        {
+          add(static_cast<Int32>(value));
+        }
+        else if constexpr (std::is_enum<T>::value)
+        {
+          add(to_integral(value));
+        }
+        else if constexpr (std::is_integral<T>::value && std::is_signed<T>::value)
+        {
+          if constexpr (sizeof(T) <= 4)
+          {
+            put(ArgType::Int32, static_cast<Int32>(value));
+          }
+          else
+          {
+            put(ArgType::Int64, static_cast<Sint64>(value));
+          }
+        }
+        else if constexpr (std::is_integral<T>::value)
+        {
+          if constexpr (sizeof(T) <= 4)
+          {
+            put(ArgType::UInt32, static_cast<UInt32>(value));
+          }
+          else
+          {
+            put(ArgType::UInt64, static_cast<Uint64>(value));
+          }
+        }
+        else if constexpr (std::is_floating_point<T>::value)
+        {
+          put(ArgType::Float64, static_cast<Float64>(value));
+        }
+        else if constexpr (std::is_convertible<const T&, const char*>::value)
+        {
+          const char* str = value;
+          add_string(str != nullptr ? str : "(null)", str != nullptr ? std::strlen(str) : 6);
+        }
+        else if constexpr (std::is_same<T, String>::value)
+        {
+          add_string(value.data(), value.size());
+        }
+        else if constexpr (std::is_pointer<T>::value)
+        {
+          put(ArgType::Pointer, static_cast<Uint64>(reinterpret_cast<std::uintptr_t>(value)));
+        }
+        else
+        {
+          static_assert(std::is_pointer<T>::value, "This type can not be logged");
+        }
+      }
+
+      UInt32 size() const { return m_size; }
+
+    private:
+      template<class TValue>
+      void put(ArgType type, TValue value)
+      {
+        if (m_size + 1 + sizeof(TValue) <= m_capacity)
+        {
+          m_buffer[m_size] = static_cast<UInt8>(type);
+          std::memcpy(m_buffer + m_size + 1, &value, sizeof(TValue));
+          m_size += 1 + sizeof(TValue);
+        }
+        else
+        {
+          m_size = m_capacity;
+        }
+      }
+
+      void add_string(const char* str, size_t length)
+      {
+        // Type, length and as much of the string as fits
+        if (m_size + 3 > m_capacity)
+        {
+          m_size = m_capacity;
+          return;
+        }
+
+        const UInt16 kept = static_cast<UInt16>(std::min<size_t>(length, m_capacity - m_size - 3));
+        m_buffer[m_size] = static_cast<UInt8>(ArgType::String);
+        std::memcpy(m_buffer + m_size + 1, &kept, sizeof(kept));
+        std::memcpy(m_buffer + m_size + 3, str, kept);
+        m_size += 3 + kept;
+      }
+
+      UInt8* m_buffer;
+      UInt32 m_capacity;
+      UInt32 m_size;
+    };
+
+    namespace detail
+    {
+      // Lowest level logged for each category, read on every log call
+      extern std::atomic<UInt8> categoryLevels[to_integral(LogCategory::Count)];
+    }
+
+    // Returns if a message would be logged, costs a load and a compare
+    inline bool is_enabled(LogLevel level, LogCategory category)
+    {
+      return to_integral(level) >= detail::categoryLevels[to_integral(category)].load(std::memory_order_relaxed);
+    }
+
+    // Sets the lowest level logged for a category, Off disables it. Every
+    // category starts at Trace, levels compiled out stay out.
+    void set_category_level(LogCategory category, LogLevel level);
+    LogLevel category_level(LogCategory category);
+
+    // Sets every category at once
+    void set_level(LogLevel level);
+
+    // Returns the name of a category as printed in the log
+    const char* category_name(LogCategory category);
+
+    // Looks up a level or category by name, ignoring case. Returns false
+    // if the name is unknown.
+    bool parse_level(const char* name, LogLevel& level);
+    bool parse_category(const char* name, LogCategory& category);
+
+    // Opens the log file and starts the writer thread, returns false if the
+    // file could not be opened. Until start is called messages go straight
+    // to stdout. Start and stop while no other thread is logging.
+    bool start(const LoggerSettings& settings = LoggerSettings());
+
+    // Writes every queued message and stops the writer thread
+    void stop();
+
+    // Returns if the writer thread is running
+    bool is_running();
+
+    // Adds a format string to the table written to binary logs and returns
+    // its ID. The string must live for the whole program (a literal), the
+    // LSE_LOG macros register each call site once.
+    FormatId register_format(const char* format);
+
+    // Queues a message whose arguments are already encoded. Never blocks or
+    // touches the file, safe from any thread. Fatal messages are flushed
+    // before returning.
+    void write_encoded(LogLevel level, LogCategory category, FormatId format, const UInt8* payload, UInt32 size);
+
+    // Encodes the arguments of a registered format and queues the message
+    template<class... TArgs>
+    void log(LogLevel level, LogCategory category, FormatId format, const TArgs&... args)
+    {
+      UInt8 payload[MaxPayloadSize];
+      ArgEncoder encoder(payload, MaxPayloadSize);
+      (encoder.add(args), ...);
+      write_encoded(level, category, format, payload, encoder.size());
+    }
+
+    // Formats a message printf style straight away and queues the text, for
+    // format strings only known at runtime. Filtered like the macros.
+    void write(LogLevel level, LogCategory category, const char* format, ...);
+    void write_args(LogLevel level, LogCategory category, const char* format, va_list args);
+
+    // Blocks until every message queued so far has been written
+    void flush();
+
+    // Number of messages dropped because the queue was full
+    Uint64 dropped_count();
+
+    // Returns the name of a level as printed in the log
+    const char* level_name(LogLevel level);
+
+    // Formats a printf style format string with arguments recorded by an
+    // ArgEncoder and appends the text to out
+    void format_message(const char* format, const UInt8* payload, UInt32 size, String& out);
+
+    // Appends one log line, the same way in the log file and the decoder
+    void format_line(String& out, Float64 seconds, LogLevel level, LogCategory category, UInt32 thread, const char* format,
+      const UInt8* payload, UInt32 size);
+
+    // Layout of a binary log. A header is followed by chunks, each starting
+    // with a ChunkType byte. All values are little endian.
+    //   Header:  Magic, UInt32 version, Uint64 timer frequency, Uint64 start time
+    //   Format:  UInt32 ID, UInt16 length, format string. Written before the
+    //            first message using the format, so each file is complete.
+    //   Message: Uint64 time, UInt32 thread, UInt8 level, UInt8 category,
+    //            UInt32 format ID, UInt16 size, encoded arguments
+    //   Dropped: UInt32 number of messages dropped since the last one
+    namespace binary
+    {
+      const char Magic[8] = "LSELOG1";
+      const UInt32 Version = 2;
+
+      enum class ChunkType : UInt8
+      {
+        Format = 'F',
+        Message = 'M',
+        Dropped = 'D'
+      };
+    }
+
+    // Turns a binary log back into the text the logger would have written,
+    // returns false if the file could not be read or is not a binary log
+    bool decode(const String& path, std::ostream& out);
+  }
+}
+
+// Queue a printf style message at the given level and category. The format
+// must be a string literal, it is stored once and only the arguments are
+// recorded. Nothing, including the arguments, is evaluated when the category
+// is filtered out.
+#define LSE_LOG(level, category, format, ...) \
+  do \
+  { \
+    if (::lse::logger::is_enabled(level, category)) \
+    { \
+      static const ::lse::logger::FormatId lseLogFormat = ::lse::logger::register_format("" format); \
+      ::lse::logger::log(level, category, lseLogFormat, ##__VA_ARGS__); \
+    } \
+  } while (0)
+
+// Level macros take the category by name, e.g. LSE_LOG_INFO(Render, ...).
+// Levels below LSE_LOG_MIN_LEVEL compile to nothing.
+#define LSE_LOG_DISABLED(...) do { } while (0)
+
+#if LSE_LOG_MIN_LEVEL <= LSE_LOG_LEVEL_TRACE
+#define LSE_LOG_TRACE(category, ...) LSE_LOG(::lse::LogLevel::Trace, ::lse::LogCategory::category, __VA_ARGS__)
+#else
+#define LSE_LOG_TRACE(...) LSE_LOG_DISABLED(__VA_ARGS__)
+#endif
+
+#if LSE_LOG_MIN_LEVEL <= LSE_LOG_LEVEL_DEBUG
+#define LSE_LOG_DEBUG(category, ...) LSE_LOG(::lse::LogLevel::Debug, ::lse::LogCategory::category, __VA_ARGS__)
+#else
+#define LSE_LOG_DEBUG(...) LSE_LOG_DISABLED(__VA_ARGS__)
+#endif
+
+#if LSE_LOG_MIN_LEVEL <= LSE_LOG_LEVEL_INFO
+#define LSE_LOG_INFO(category, ...) LSE_LOG(::lse::LogLevel::Info, ::lse::LogCategory::category, __VA_ARGS__)
+#else
+#define LSE_LOG_INFO(...) LSE_LOG_DISABLED(__VA_ARGS__)
+#endif
+
+#if LSE_LOG_MIN_LEVEL <= LSE_LOG_LEVEL_WARNING
+#define LSE_LOG_WARNING(category, ...) LSE_LOG(::lse::LogLevel::Warning, ::lse::LogCategory::category, __VA_ARGS__)
+#else
+#define LSE_LOG_WARNING(...) LSE_LOG_DISABLED(__VA_ARGS__)
+#endif
+
+#if LSE_LOG_MIN_LEVEL <= LSE_LOG_LEVEL_ERROR
+#define LSE_LOG_ERROR(category, ...) LSE_LOG(::lse::LogLevel::Error, ::lse::LogCategory::category, __VA_ARGS__)
+#else
+#define LSE_LOG_ERROR(...) LSE_LOG_DISABLED(__VA_ARGS__)
+#endif
+
+#if LSE_LOG_MIN_LEVEL <= LSE_LOG_LEVEL_FATAL
+#define LSE_LOG_FATAL(category, ...) LSE_LOG(::lse::LogLevel::Fatal, ::lse::LogCategory::category, __VA_ARGS__)
+#else
+#define LSE_LOG_FATAL(...) LSE_LOG_DISABLED(__VA_ARGS__)
+#endif
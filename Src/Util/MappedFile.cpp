@@ -0,0 +1,227 @@
+/******************************************************************************
+File: MappedFile.cpp
+Created: 10/23/2026 10:12:45 AM
+Copyright (c) 2017 Turn Tactics
+
+Permission is hereby granted, free of charge, to any person obtaining a copy
+of this software and associated documentation files (the "Software"), to deal
+in the Software without restriction, including without limitation the rights
+to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+copies of the Software, and to permit persons to whom the Software is
+furnished to do so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in
+all copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+SOFTWARE.
+
+Purpose: Maps a file into memory so writes reach the file through the OS page
+         cache even if the process dies.
+
+Author: James Womack
+
+********************************************************************************/
+#include "MappedFile.h"
+
+#ifdef _WIN32
+#define WIN32_LEAN_AND_MEAN
+#define NOMINMAX
+#include <windows.h>
+#else
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+#endif
+
+namespace lse
+{
+  MappedFile::MappedFile() : m_data(nullptr), m_size(0), m_writable(false), m_file(nullptr), m_mapping(nullptr)
+  {
+  }
+
+  MappedFile::~MappedFile()
+  {
+    close();
+  }
+
+#ifdef _WIN32
+  bool MappedFile::create(const String& path, size_t bytes)
+  {
+    close();
+
+    HANDLE file = CreateFileA(path.c_str(), GENERIC_READ | GENERIC_WRITE, FILE_SHARE_READ, nullptr, CREATE_ALWAYS,
+      FILE_ATTRIBUTE_NORMAL, nullptr);
+    if (file == INVALID_HANDLE_VALUE)
+    {
+      return false;
+    }
+
+    // The mapping grows the file to its size
+    const Uint64 size = bytes;
+    HANDLE mapping = CreateFileMappingA(file, nullptr, PAGE_READWRITE, static_cast<DWORD>(size >> 32),
+      static_cast<DWORD>(size & 0xFFFFFFFF), nullptr);
+    void* data = mapping != nullptr ? MapViewOfFile(mapping, FILE_MAP_WRITE, 0, 0, bytes) : nullptr;
+    if (data == nullptr)
+    {
+      if (mapping != nullptr)
+      {
+        CloseHandle(mapping);
+      }
+      CloseHandle(file);
+      return false;
+    }
+
+    m_file = file;
+    m_mapping = mapping;
+    m_data = static_cast<UInt8*>(data);
+    m_size = bytes;
+    m_writable = true;
+    return true;
+  }
+
+  bool MappedFile::open_read(const String& path)
+  {
+    close();
+
+    HANDLE file = CreateFileA(path.c_str(), GENERIC_READ, FILE_SHARE_READ | FILE_SHARE_WRITE, nullptr, OPEN_EXISTING,
+      FILE_ATTRIBUTE_NORMAL, nullptr);
+    if (file == INVALID_HANDLE_VALUE)
+    {
+      return false;
+    }
+
+    LARGE_INTEGER size;
+    if (!GetFileSizeEx(file, &size) || size.QuadPart == 0)
+    {
+      CloseHandle(file);
+      return false;
+    }
+
+    HANDLE mapping = CreateFileMappingA(file, nullptr, PAGE_READONLY, 0, 0, nullptr);
+    void* data = mapping != nullptr ? MapViewOfFile(mapping, FILE_MAP_READ, 0, 0, 0) : nullptr;
+    if (data == nullptr)
+    {
+      if (mapping != nullptr)
+      {
+        CloseHandle(mapping);
+      }
+      CloseHandle(file);
+      return false;
+    }
+
+    m_file = file;
+    m_mapping = mapping;
+    m_data = static_cast<UInt8*>(data);
+    m_size = static_cast<size_t>(size.QuadPart);
+    m_writable = false;
+    return true;
+  }
+
+  void MappedFile::flush()
+  {
+    if (m_data != nullptr && m_writable)
+    {
+      FlushViewOfFile(m_data, 0);
+    }
+  }
+
+  void MappedFile::close()
+  {
+    if (m_data == nullptr)
+    {
+      return;
+    }
+
+    flush();
+    UnmapViewOfFile(m_data);
+    CloseHandle(static_cast<HANDLE>(m_mapping));
+    CloseHandle(static_cast<HANDLE>(m_file));
+
+    m_data = nullptr;
+    m_size = 0;
+    m_mapping = nullptr;
+    m_file = nullptr;
+  }
+#else
+  bool MappedFile::create(const String& path, size_t bytes)
+  {
+    close();
+
+    const int file = ::open(path.c_str(), O_RDWR | O_CREAT | O_TRUNC, 0644);
+    if (file < 0)
+    {
+      return false;
+    }
+
+    void* data = ftruncate(file, static_cast<off_t>(bytes)) == 0
+      ? mmap(nullptr, bytes, PROT_READ | PROT_WRITE, MAP_SHARED, file, 0) : MAP_FAILED;
+
+    // The mapping keeps the file open
+    ::close(file);
+    if (data == MAP_FAILED)
+    {
+      return false;
+    }
+
+    m_data = static_cast<UInt8*>(data);
+    m_size = bytes;
+    m_writable = true;
+    return true;
+  }
+
+  bool MappedFile::open_read(const String& path)
+  {
+    close();
+
+    const int file = ::open(path.c_str(), O_RDONLY);
+    if (file < 0)
+    {
+      return false;
+    }
+
+    struct stat info;
+    void* data = fstat(file, &info) == 0 && info.st_size > 0
+      ? mmap(nullptr, static_cast<size_t>(info.st_size), PROT_READ, MAP_PRIVATE, file, 0) : MAP_FAILED;
+
+    ::close(file);
+    if (data == MAP_FAILED)
+    {
+      return false;
+    }
+
+    m_data = static_cast<UInt8*>(data);
+    m_size = static_cast<size_t>(info.st_size);
+    m_writable = false;
+    return true;
+  }
+
+  void MappedFile::flush()
+  {
+    if (m_data != nullptr && m_writable)
+    {
+      msync(m_data, m_size, MS_SYNC);
+    }
+  }
+
+  void MappedFile::close()
+  {
+    if (m_data == nullptr)
+    {
+      return;
+    }
+
+    flush();
+    munmap(m_data, m_size);
+
+    m_data = nullptr;
+    m_size = 0;
+  }
+#endif
+}
@@ -0,0 +1,74 @@
+/******************************************************************************
+File: MappedFile.h
+Created: 10/23/2026 10:12:45 AM
+Copyright (c) 2017 Turn Tactics
+
+Permission is hereby granted, free of charge, to any person obtaining a copy
+of this software and associated documentation files (the "Software"), to deal
+in the Software without restriction, including without limitation the rights
+to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+copies of the Software, and to permit persons to whom the Software is
+furnished to do so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in
+all copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+SOFTWARE.
+
+Purpose: Maps a file into memory so writes reach the file through the OS page
+         cache even if the process dies.
+
+Author: James Womack
+
+********************************************************************************/
+#pragma once
+
+#include "../Common.h"
+
+namespace lse
+{
+  // A file mapped into memory. Writes to a created mapping are shared with
+  // the file, the OS writes them out even if the process crashes.
+  class MappedFile
+  {
+  public:
+    MappedFile();
+    ~MappedFile();
+
+    MappedFile(const MappedFile&) = delete;
+    MappedFile& operator=(const MappedFile&) = delete;
+
+    // Creates or truncates a file of the given size and maps it for
+    // reading and writing, the contents start zeroed
+    bool create(const String& path, size_t bytes);
+
+    // Maps an existing file for reading only
+    bool open_read(const String& path);
+
+    // Asks the OS to write changes out now rather than when it chooses
+    void flush();
+
+    // Unmaps and closes the file, writing out any changes
+    void close();
+
+    bool is_open() const { return m_data != nullptr; }
+    UInt8* data() { return m_data; }
+    const UInt8* data() const { return m_data; }
+    size_t size() const { return m_size; }
+
+  private:
+    UInt8* m_data;
+    size_t m_size;
+    bool m_writable;
+
+    // Platform handles for the file and its mapping
+    void* m_file;
+    void* m_mapping;
+  };
+}
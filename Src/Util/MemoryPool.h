@@ -31,3 +31,257 @@ Author: James Womack
 #pragma once
 
 #include "../Common.h"
+#include "Logger.h"
+#include "MemoryTracker.h"
+
+#include <cassert>
+#include <cstdint>
+#include <cstring>
+#include <new>
+#include <utility>
+
+// Debug pools poison their blocks and check every free, define LSE_POOL_DEBUG
+// as 1 or 0 to force it on or off
+#ifndef LSE_POOL_DEBUG
+#ifdef NDEBUG
+#define LSE_POOL_DEBUG 0
+#else
+#define LSE_POOL_DEBUG 1
+#endif
+#endif
+
+namespace lse
+{
+  // Size of a cache line on the machines we target
+  const size_t CacheLineSize = 64;
+
+  // A pool of fixed size blocks for objects of type T. Blocks are carved out
+  // of large slabs and handed out from an intrusive free list, so allocating
+  // and freeing are both O(1) and never touch the general heap once a slab
+  // exists. Every block starts on a cache line boundary so two objects never
+  // share a line. Not thread safe.
+  //
+  // In debug builds free blocks are filled with a poison pattern that is
+  // checked when they are handed out again, catching writes after free, and
+  // every free is checked against the pool to catch double frees and
+  // pointers that did not come from it.
+  //
+  // Handed out blocks are charged to the pool's memory tag.
+  template<class T, size_t BlocksPerSlab = 256>
+  class MemoryPool
+  {
+  public:
+    static_assert(BlocksPerSlab > 0, "A slab needs at least one block");
+
+    // Alignment and stride of every block
+    static const size_t BlockAlignment = alignof(T) > CacheLineSize ? alignof(T) : CacheLineSize;
+    static const size_t BlockSize = ((sizeof(T) > sizeof(void*) ? sizeof(T) : sizeof(void*))
+      + BlockAlignment - 1) / BlockAlignment * BlockAlignment;
+
+    explicit MemoryPool(MemoryTag tag = MemoryTag::General) :
+      m_tag(tag), m_freeList(nullptr), m_allocated(0)
+    {
+    }
+
+    ~MemoryPool()
+    {
+#if LSE_POOL_DEBUG
+      if (m_allocated > 0)
+      {
+        LSE_LOG_WARNING(General, "MemoryPool destroyed with %u blocks still allocated!", static_cast<UInt32>(m_allocated));
+      }
+#endif
+
+      for (const Slab& slab : m_slabs)
+      {
+        ::operator delete(slab.memory);
+      }
+    }
+
+    MemoryPool(const MemoryPool&) = delete;
+    MemoryPool& operator=(const MemoryPool&) = delete;
+
+    // Returns an uninitialized block big enough for a T
+    void* allocate()
+    {
+      if (m_freeList == nullptr)
+      {
+        add_slab();
+      }
+
+      FreeBlock* block = m_freeList;
+      m_freeList = block->next;
+      ++m_allocated;
+      LSE_MEMORY_ALLOC(m_tag, BlockSize);
+
+#if LSE_POOL_DEBUG
+      check_poison(block);
+      mark(block, true);
+      std::memset(block, AllocatedPattern, BlockSize);
+#endif
+
+      return block;
+    }
+
+    // Returns a block to the pool, null is ignored
+    void deallocate(void* pointer)
+    {
+      if (pointer == nullptr)
+      {
+        return;
+      }
+
+#if LSE_POOL_DEBUG
+      // A bad free is reported and then ignored rather than corrupting the
+      // free list
+      if (!mark(pointer, false))
+      {
+        return;
+      }
+
+      std::memset(pointer, FreedPattern, BlockSize);
+#endif
+
+      FreeBlock* block = static_cast<FreeBlock*>(pointer);
+      block->next = m_freeList;
+      m_freeList = block;
+      --m_allocated;
+      LSE_MEMORY_FREE(m_tag, BlockSize);
+    }
+
+    // Allocates a block and constructs a T in it
+    template<class... TArgs>
+    T* create(TArgs&&... args)
+    {
+      void* block = allocate();
+      return new (block) T(std::forward<TArgs>(args)...);
+    }
+
+    // Destroys a T made by create and frees its block, null is ignored
+    void destroy(T* object)
+    {
+      if (object != nullptr)
+      {
+        object->~T();
+        deallocate(object);
+      }
+    }
+
+    // Allocates slabs until at least count blocks exist
+    void reserve(size_t count)
+    {
+      while (capacity() < count)
+      {
+        add_slab();
+      }
+    }
+
+    // Number of blocks handed out and not freed
+    size_t allocated_count() const { return m_allocated; }
+
+    // Number of blocks in every slab, free or not
+    size_t capacity() const { return m_slabs.size() * BlocksPerSlab; }
+
+    // Bytes of memory taken from the heap for slabs
+    size_t reserved_bytes() const { return m_slabs.size() * SlabBytes; }
+
+  private:
+    struct FreeBlock
+    {
+      FreeBlock* next;
+    };
+
+    struct Slab
+    {
+      // What the heap returned, blocks start at the first aligned address
+      void* memory;
+      UInt8* blocks;
+    };
+
+    static const size_t SlabBytes = BlockSize * BlocksPerSlab + BlockAlignment;
+    static const UInt8 FreedPattern = 0xDD;
+    static const UInt8 AllocatedPattern = 0xCD;
+
+    void add_slab()
+    {
+      Slab slab;
+      slab.memory = ::operator new(SlabBytes);
+
+      const std::uintptr_t address = reinterpret_cast<std::uintptr_t>(slab.memory);
+      slab.blocks = reinterpret_cast<UInt8*>((address + BlockAlignment - 1) / BlockAlignment * BlockAlignment);
+
+#if LSE_POOL_DEBUG
+      std::memset(slab.blocks, FreedPattern, BlockSize * BlocksPerSlab);
+      m_blockAllocated.reserve(m_blockAllocated.size() + BlocksPerSlab);
+      for (size_t i = 0; i < BlocksPerSlab; ++i)
+      {
+        m_blockAllocated.emplace(slab.blocks + i * BlockSize, false);
+      }
+#endif
+
+      // Thread the new blocks onto the free list in address order
+      for (size_t i = BlocksPerSlab; i > 0; --i)
+      {
+        FreeBlock* block = reinterpret_cast<FreeBlock*>(slab.blocks + (i - 1) * BlockSize);
+        block->next = m_freeList;
+        m_freeList = block;
+      }
+
+      m_slabs.push_back(std::move(slab));
+    }
+
+#if LSE_POOL_DEBUG
+    // Flags a block as allocated or free, returns false on double frees and
+    // pointers that are not blocks of this pool
+    bool mark(void* pointer, bool allocated)
+    {
+      const auto it = m_blockAllocated.find(pointer);
+      if (it == m_blockAllocated.end())
+      {
+        LSE_LOG_ERROR(General, "MemoryPool freed a pointer %p that is not one of its blocks!", pointer);
+        logger::flush();
+        assert(false);
+        return false;
+      }
+
+      if (!allocated && !it->second)
+      {
+        LSE_LOG_ERROR(General, "MemoryPool block %p was freed twice!", pointer);
+        logger::flush();
+        assert(false);
+        return false;
+      }
+
+      it->second = allocated;
+      return true;
+    }
+
+    // Checks a free block was not written to while it was free
+    void check_poison(const FreeBlock* block) const
+    {
+      const UInt8* bytes = reinterpret_cast<const UInt8*>(block);
+      for (size_t i = sizeof(FreeBlock); i < BlockSize; ++i)
+      {
+        if (bytes[i] != FreedPattern)
+        {
+          LSE_LOG_ERROR(General, "MemoryPool block %p was written to after being freed!", static_cast<const void*>(block));
+          logger::flush();
+          assert(false);
+          return;
+        }
+      }
+    }
+#endif
+
+    MemoryTag m_tag;
+    FreeBlock* m_freeList;
+    size_t m_allocated;
+    containers::Vector<Slab> m_slabs;
+
+#if LSE_POOL_DEBUG
+    // Whether each block is handed out, looked up by address so checking a
+    // free stays O(1) however many slabs there are
+    containers::UnorderedMap<const void*, bool> m_blockAllocated;
+#endif
+  };
+}
@@ -0,0 +1,135 @@
+/******************************************************************************
+File: MemoryResource.cpp
+Created: 10/19/2026 4:20:36 PM
+Copyright (c) 2017 Turn Tactics
+
+Permission is hereby granted, free of charge, to any person obtaining a copy
+of this software and associated documentation files (the "Software"), to deal
+in the Software without restriction, including without limitation the rights
+to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+copies of the Software, and to permit persons to whom the Software is
+furnished to do so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in
+all copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+SOFTWARE.
+
+Purpose: Defines memory resources backed by the engine's arenas and pools so
+         the containers::pmr aliases can be pointed at them.
+
+Author: James Womack
+
+********************************************************************************/
+#include "MemoryResource.h"
+
+namespace lse
+{
+  void* ArenaResource::do_allocate(size_t bytes, size_t alignment)
+  {
+    return m_arena->allocate(bytes, alignment);
+  }
+
+  void ArenaResource::do_deallocate(void*, size_t, size_t)
+  {
+    // Freed when the arena resets
+  }
+
+  bool ArenaResource::do_is_equal(const std::pmr::memory_resource& other) const noexcept
+  {
+    const ArenaResource* resource = dynamic_cast<const ArenaResource*>(&other);
+    return resource != nullptr && resource->m_arena == m_arena;
+  }
+
+  size_t PoolResource::reserved_bytes() const
+  {
+    return m_pool64.reserved_bytes() + m_pool128.reserved_bytes() + m_pool256.reserved_bytes() +
+      m_pool512.reserved_bytes() + m_pool1024.reserved_bytes();
+  }
+
+  void* PoolResource::do_allocate(size_t bytes, size_t alignment)
+  {
+    // Pool blocks are cache line aligned so only bigger alignments go upstream
+    if (alignment > CacheLineSize || bytes > MaxPooledSize)
+    {
+      return m_upstream->allocate(bytes, alignment);
+    }
+
+    if (bytes <= 64)
+    {
+      return m_pool64.allocate();
+    }
+    if (bytes <= 128)
+    {
+      return m_pool128.allocate();
+    }
+    if (bytes <= 256)
+    {
+      return m_pool256.allocate();
+    }
+    if (bytes <= 512)
+    {
+      return m_pool512.allocate();
+    }
+    return m_pool1024.allocate();
+  }
+
+  void PoolResource::do_deallocate(void* pointer, size_t bytes, size_t alignment)
+  {
+    if (alignment > CacheLineSize || bytes > MaxPooledSize)
+    {
+      m_upstream->deallocate(pointer, bytes, alignment);
+    }
+    else if (bytes <= 64)
+    {
+      m_pool64.deallocate(pointer);
+    }
+    else if (bytes <= 128)
+    {
+      m_pool128.deallocate(pointer);
+    }
+    else if (bytes <= 256)
+    {
+      m_pool256.deallocate(pointer);
+    }
+    else if (bytes <= 512)
+    {
+      m_pool512.deallocate(pointer);
+    }
+    else
+    {
+      m_pool1024.deallocate(pointer);
+    }
+  }
+
+  bool PoolResource::do_is_equal(const std::pmr::memory_resource& other) const noexcept
+  {
+    // Blocks can only go back to the pools they came from
+    return this == &other;
+  }
+
+  void* TrackingResource::do_allocate(size_t bytes, size_t alignment)
+  {
+    void* pointer = m_upstream->allocate(bytes, alignment);
+    LSE_MEMORY_ALLOC(m_tag, bytes);
+    return pointer;
+  }
+
+  void TrackingResource::do_deallocate(void* pointer, size_t bytes, size_t alignment)
+  {
+    LSE_MEMORY_FREE(m_tag, bytes);
+    m_upstream->deallocate(pointer, bytes, alignment);
+  }
+
+  bool TrackingResource::do_is_equal(const std::pmr::memory_resource& other) const noexcept
+  {
+    const TrackingResource* resource = dynamic_cast<const TrackingResource*>(&other);
+    return resource != nullptr && resource->m_tag == m_tag && resource->m_upstream->is_equal(*m_upstream);
+  }
+}
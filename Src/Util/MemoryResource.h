@@ -0,0 +1,128 @@
+/******************************************************************************
+File: MemoryResource.h
+Created: 10/19/2026 4:20:36 PM
+Copyright (c) 2017 Turn Tactics
+
+Permission is hereby granted, free of charge, to any person obtaining a copy
+of this software and associated documentation files (the "Software"), to deal
+in the Software without restriction, including without limitation the rights
+to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+copies of the Software, and to permit persons to whom the Software is
+furnished to do so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in
+all copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+SOFTWARE.
+
+Purpose: Defines memory resources backed by the engine's arenas and pools so
+         the containers::pmr aliases can be pointed at them.
+
+Author: James Womack
+
+********************************************************************************/
+#pragma once
+
+#include "../Common.h"
+#include "FrameArena.h"
+#include "MemoryPool.h"
+#include "MemoryTracker.h"
+
+namespace lse
+{
+  // Memory resource that bumps through a LinearArena. Deallocation does
+  // nothing, everything comes back when the arena is reset, so containers
+  // using it must be dropped or cleared before then. Keeping a whole system's
+  // containers in one arena puts them in a single region that is freed in
+  // one go.
+  class ArenaResource : public std::pmr::memory_resource
+  {
+  public:
+    explicit ArenaResource(LinearArena& arena) : m_arena(&arena) {}
+
+    LinearArena& arena() const { return *m_arena; }
+
+  private:
+    void* do_allocate(size_t bytes, size_t alignment) override;
+    void do_deallocate(void* pointer, size_t bytes, size_t alignment) override;
+    bool do_is_equal(const std::pmr::memory_resource& other) const noexcept override;
+
+    LinearArena* m_arena;
+  };
+
+  // Memory resource that serves small allocations from MemoryPools, one per
+  // size class, and passes anything bigger or more aligned than a cache line
+  // to an upstream resource. Suits node based containers such as Map and
+  // UnorderedMap that make many small allocations of the same size. Pooled
+  // blocks are charged to the given memory tag. Not thread safe.
+  class PoolResource : public std::pmr::memory_resource
+  {
+  public:
+    explicit PoolResource(MemoryTag tag = MemoryTag::General,
+      std::pmr::memory_resource* upstream = std::pmr::get_default_resource()) :
+      m_upstream(upstream), m_pool64(tag), m_pool128(tag), m_pool256(tag), m_pool512(tag), m_pool1024(tag)
+    {
+    }
+
+    PoolResource(const PoolResource&) = delete;
+    PoolResource& operator=(const PoolResource&) = delete;
+
+    // Largest allocation served from a pool
+    static const size_t MaxPooledSize = 1024;
+
+    std::pmr::memory_resource* upstream() const { return m_upstream; }
+
+    // Bytes taken from the heap for pool slabs
+    size_t reserved_bytes() const;
+
+  private:
+    template<size_t Size>
+    struct Block
+    {
+      UInt8 bytes[Size];
+    };
+
+    static const size_t BlocksPerSlab = 64;
+
+    void* do_allocate(size_t bytes, size_t alignment) override;
+    void do_deallocate(void* pointer, size_t bytes, size_t alignment) override;
+    bool do_is_equal(const std::pmr::memory_resource& other) const noexcept override;
+
+    std::pmr::memory_resource* m_upstream;
+    MemoryPool<Block<64>, BlocksPerSlab> m_pool64;
+    MemoryPool<Block<128>, BlocksPerSlab> m_pool128;
+    MemoryPool<Block<256>, BlocksPerSlab> m_pool256;
+    MemoryPool<Block<512>, BlocksPerSlab> m_pool512;
+    MemoryPool<Block<1024>, BlocksPerSlab> m_pool1024;
+  };
+
+  // Memory resource that passes everything to an upstream resource and
+  // charges it to a memory tag, for containers of a subsystem that has no
+  // pool or arena of its own
+  class TrackingResource : public std::pmr::memory_resource
+  {
+  public:
+    explicit TrackingResource(MemoryTag tag,
+      std::pmr::memory_resource* upstream = std::pmr::get_default_resource()) :
+      m_tag(tag), m_upstream(upstream)
+    {
+    }
+
+    MemoryTag tag() const { return m_tag; }
+    std::pmr::memory_resource* upstream() const { return m_upstream; }
+
+  private:
+    void* do_allocate(size_t bytes, size_t alignment) override;
+    void do_deallocate(void* pointer, size_t bytes, size_t alignment) override;
+    bool do_is_equal(const std::pmr::memory_resource& other) const noexcept override;
+
+    MemoryTag m_tag;
+    std::pmr::memory_resource* m_upstream;
+  };
+}
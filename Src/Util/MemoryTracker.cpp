@@ -0,0 +1,179 @@
+/******************************************************************************
+File: MemoryTracker.cpp
+Created: 10/20/2026 1:15:48 PM
+Copyright (c) 2017 Turn Tactics
+
+Permission is hereby granted, free of charge, to any person obtaining a copy
+of this software and associated documentation files (the "Software"), to deal
+in the Software without restriction, including without limitation the rights
+to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+copies of the Software, and to permit persons to whom the Software is
+furnished to do so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in
+all copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+SOFTWARE.
+
+Purpose: Defines tagged memory accounting so the memory each subsystem uses can
+         be reported per frame, checked against a budget and listed as
+         leaks at shutdown.
+
+Author: James Womack
+
+********************************************************************************/
+#include "MemoryTracker.h"
+#include "Logger.h"
+
+#include <atomic>
+#include <cassert>
+
+namespace lse
+{
+  namespace memory
+  {
+    namespace
+    {
+      const size_t TagCount = static_cast<size_t>(MemoryTag::Count);
+
+      const char* const TagNames[TagCount] =
+      {
+        "General",
+        "Render",
+        "Texture",
+        "Audio",
+        "Map",
+        "AI",
+        "Frame"
+      };
+
+      struct TagData
+      {
+        std::atomic<size_t> liveBytes{ 0 };
+        std::atomic<size_t> peakBytes{ 0 };
+        std::atomic<size_t> liveAllocations{ 0 };
+        std::atomic<size_t> totalAllocations{ 0 };
+        std::atomic<size_t> frameBytes{ 0 };
+        std::atomic<size_t> frameAllocations{ 0 };
+        std::atomic<size_t> lastFrameBytes{ 0 };
+        std::atomic<size_t> lastFrameAllocations{ 0 };
+        std::atomic<size_t> budgetBytes{ 0 };
+
+        // Set while over budget so an overrun is only reported once
+        std::atomic<bool> overBudget{ false };
+      };
+
+      // Function static so allocations made during static initialization
+      // are counted safely
+      TagData* tags()
+      {
+        static TagData s_tags[TagCount];
+        return s_tags;
+      }
+
+      TagData& data(MemoryTag tag)
+      {
+        return tags()[static_cast<size_t>(tag)];
+      }
+    }
+
+    const char* tag_name(MemoryTag tag)
+    {
+      return tag < MemoryTag::Count ? TagNames[static_cast<size_t>(tag)] : "Unknown";
+    }
+
+    void record_allocation(MemoryTag tag, size_t bytes)
+    {
+      TagData& tagData = data(tag);
+      const size_t live = tagData.liveBytes.fetch_add(bytes, std::memory_order_relaxed) + bytes;
+      tagData.liveAllocations.fetch_add(1, std::memory_order_relaxed);
+      tagData.totalAllocations.fetch_add(1, std::memory_order_relaxed);
+      tagData.frameBytes.fetch_add(bytes, std::memory_order_relaxed);
+      tagData.frameAllocations.fetch_add(1, std::memory_order_relaxed);
+
+      size_t peak = tagData.peakBytes.load(std::memory_order_relaxed);
+      while (live > peak && !tagData.peakBytes.compare_exchange_weak(peak, live, std::memory_order_relaxed))
+      {
+      }
+
+      const size_t budget = tagData.budgetBytes.load(std::memory_order_relaxed);
+      if (budget > 0 && live > budget && !tagData.overBudget.exchange(true, std::memory_order_relaxed))
+      {
+        LSE_LOG_ERROR(General, "Memory tag %s is over budget, %u KB used of %u KB!", tag_name(tag),
+          static_cast<UInt32>(live / 1024), static_cast<UInt32>(budget / 1024));
+        logger::flush();
+        assert(false);
+      }
+    }
+
+    void record_free(MemoryTag tag, size_t bytes, size_t allocations)
+    {
+      TagData& tagData = data(tag);
+      const size_t live = tagData.liveBytes.fetch_sub(bytes, std::memory_order_relaxed) - bytes;
+      tagData.liveAllocations.fetch_sub(allocations, std::memory_order_relaxed);
+
+      if (live <= tagData.budgetBytes.load(std::memory_order_relaxed))
+      {
+        tagData.overBudget.store(false, std::memory_order_relaxed);
+      }
+    }
+
+    void set_budget(MemoryTag tag, size_t bytes)
+    {
+      TagData& tagData = data(tag);
+      tagData.budgetBytes.store(bytes, std::memory_order_relaxed);
+      tagData.overBudget.store(false, std::memory_order_relaxed);
+    }
+
+    void end_frame()
+    {
+      for (size_t i = 0; i < TagCount; ++i)
+      {
+        TagData& tagData = tags()[i];
+        tagData.lastFrameBytes.store(tagData.frameBytes.exchange(0, std::memory_order_relaxed),
+          std::memory_order_relaxed);
+        tagData.lastFrameAllocations.store(tagData.frameAllocations.exchange(0, std::memory_order_relaxed),
+          std::memory_order_relaxed);
+      }
+    }
+
+    TagStats stats(MemoryTag tag)
+    {
+      const TagData& tagData = data(tag);
+
+      TagStats result;
+      result.liveBytes = tagData.liveBytes.load(std::memory_order_relaxed);
+      result.peakBytes = tagData.peakBytes.load(std::memory_order_relaxed);
+      result.liveAllocations = tagData.liveAllocations.load(std::memory_order_relaxed);
+      result.totalAllocations = tagData.totalAllocations.load(std::memory_order_relaxed);
+      result.frameBytes = tagData.lastFrameBytes.load(std::memory_order_relaxed);
+      result.frameAllocations = tagData.lastFrameAllocations.load(std::memory_order_relaxed);
+      result.budgetBytes = tagData.budgetBytes.load(std::memory_order_relaxed);
+      return result;
+    }
+
+    UInt32 report_leaks()
+    {
+      UInt32 leaks = 0;
+      for (size_t i = 0; i < TagCount; ++i)
+      {
+        const MemoryTag tag = static_cast<MemoryTag>(i);
+        const TagStats tagStats = stats(tag);
+        if (tagStats.liveAllocations > 0 || tagStats.liveBytes > 0)
+        {
+          LSE_LOG_WARNING(General, "Memory tag %s leaked %u allocations totalling %u bytes!", tag_name(tag),
+            static_cast<UInt32>(tagStats.liveAllocations), static_cast<UInt32>(tagStats.liveBytes));
+          ++leaks;
+        }
+      }
+
+      return leaks;
+    }
+  }
+}
@@ -0,0 +1,118 @@
+/******************************************************************************
+File: MemoryTracker.h
+Created: 10/20/2026 1:15:48 PM
+Copyright (c) 2017 Turn Tactics
+
+Permission is hereby granted, free of charge, to any person obtaining a copy
+of this software and associated documentation files (the "Software"), to deal
+in the Software without restriction, including without limitation the rights
+to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+copies of the Software, and to permit persons to whom the Software is
+furnished to do so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in
+all copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+SOFTWARE.
+
+Purpose: Defines tagged memory accounting so the memory each subsystem uses can
+         be reported per frame, checked against a budget and listed as
+         leaks at shutdown.
+
+Author: James Womack
+
+********************************************************************************/
+#pragma once
+
+#include "../Common.h"
+
+#include <cstddef>
+
+// Memory tracking is compiled into debug builds only, define
+// LSE_MEMORY_TRACKING as 1 or 0 to force it on or off
+#ifndef LSE_MEMORY_TRACKING
+#ifdef NDEBUG
+#define LSE_MEMORY_TRACKING 0
+#else
+#define LSE_MEMORY_TRACKING 1
+#endif
+#endif
+
+#if LSE_MEMORY_TRACKING
+// Charges bytes to a tag
+#define LSE_MEMORY_ALLOC(tag, bytes) ::lse::memory::record_allocation(tag, bytes)
+// Credits bytes back to a tag
+#define LSE_MEMORY_FREE(tag, bytes) ::lse::memory::record_free(tag, bytes)
+// Credits several allocations totalling bytes back to a tag at once
+#define LSE_MEMORY_FREE_MANY(tag, bytes, allocations) ::lse::memory::record_free(tag, bytes, allocations)
+#else
+#define LSE_MEMORY_ALLOC(tag, bytes) do { } while (0)
+#define LSE_MEMORY_FREE(tag, bytes) do { } while (0)
+#define LSE_MEMORY_FREE_MANY(tag, bytes, allocations) do { } while (0)
+#endif
+
+namespace lse
+{
+  // The subsystem an allocation is charged to
+  enum class MemoryTag : UInt8
+  {
+    General,
+    Render,
+    Texture,
+    Audio,
+    Map,
+    AI,
+    Frame,
+    Count
+  };
+
+  namespace memory
+  {
+    // A copy of one tag's numbers, safe to keep and display
+    struct TagStats
+    {
+      // Bytes allocated and not yet freed
+      size_t liveBytes;
+      // The most live bytes there have ever been
+      size_t peakBytes;
+      // Allocations not yet freed
+      size_t liveAllocations;
+      // Allocations ever made
+      size_t totalAllocations;
+      // Bytes and allocations made during the last finished frame
+      size_t frameBytes;
+      size_t frameAllocations;
+      // Live bytes allowed before an overrun is reported, zero for no limit
+      size_t budgetBytes;
+    };
+
+    // Returns the display name of a tag
+    const char* tag_name(MemoryTag tag);
+
+    // Charges an allocation to a tag
+    void record_allocation(MemoryTag tag, size_t bytes);
+
+    // Credits frees of allocations totalling bytes back to a tag
+    void record_free(MemoryTag tag, size_t bytes, size_t allocations = 1);
+
+    // Sets the live bytes a tag may reach before an overrun is reported,
+    // zero removes the limit
+    void set_budget(MemoryTag tag, size_t bytes);
+
+    // Closes the current frame, its counts become the frame numbers in stats
+    void end_frame();
+
+    // Returns the numbers of a tag, for overlays and reports
+    TagStats stats(MemoryTag tag);
+
+    // Prints every tag that still has live allocations and returns how many
+    // there were
+    UInt32 report_leaks();
+  }
+}
@@ -0,0 +1,156 @@
+/******************************************************************************
+File: MpscQueue.h
+Created: 10/22/2026 2:14:03 PM
+Copyright (c) 2017 Turn Tactics
+
+Permission is hereby granted, free of charge, to any person obtaining a copy
+of this software and associated documentation files (the "Software"), to deal
+in the Software without restriction, including without limitation the rights
+to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+copies of the Software, and to permit persons to whom the Software is
+furnished to do so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in
+all copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+SOFTWARE.
+
+Purpose: Defines a bounded lock free queue that many threads can push to and
+         one thread drains, used to hand work to background threads without
+         ever blocking the threads producing it.
+
+Author: James Womack
+
+********************************************************************************/
+#pragma once
+
+#include "../Common.h"
+#include "MemoryPool.h"
+
+#include <atomic>
+#include <cassert>
+#include <cstddef>
+#include <memory>
+
+namespace lse
+{
+  // Bounded multi producer, single consumer queue after Dmitry Vyukov's
+  // bounded queue. Every cell carries a sequence number that says whose turn
+  // it is, so a push is one compare and swap on the write position plus a
+  // store, and producers never wait on each other or the consumer. A full
+  // queue makes try_push fail instead of blocking.
+  //
+  // Values are written and read in place through callbacks, so large values
+  // are never copied through the queue.
+  template<class T>
+  class MpscQueue
+  {
+  public:
+    // Capacity must be a power of two
+    explicit MpscQueue(size_t capacity) :
+      m_cells(new Cell[capacity]), m_mask(capacity - 1), m_writePosition(0), m_readPosition(0)
+    {
+      assert(capacity >= 2 && (capacity & (capacity - 1)) == 0);
+
+      for (size_t i = 0; i < capacity; ++i)
+      {
+        m_cells[i].sequence.store(i, std::memory_order_relaxed);
+      }
+    }
+
+    MpscQueue(const MpscQueue&) = delete;
+    MpscQueue& operator=(const MpscQueue&) = delete;
+
+    // Claims a cell and calls fill(T&) to write it, returns false without
+    // calling fill if the queue is full. Safe from any thread.
+    template<class TFill>
+    bool try_push(TFill&& fill)
+    {
+      size_t position = m_writePosition.load(std::memory_order_relaxed);
+      Cell* cell;
+
+      for (;;)
+      {
+        cell = &m_cells[position & m_mask];
+        const size_t sequence = cell->sequence.load(std::memory_order_acquire);
+        const std::ptrdiff_t difference = static_cast<std::ptrdiff_t>(sequence) - static_cast<std::ptrdiff_t>(position);
+
+        if (difference == 0)
+        {
+          // The cell is free for this position, try to claim it
+          if (m_writePosition.compare_exchange_weak(position, position + 1, std::memory_order_relaxed))
+          {
+            break;
+          }
+        }
+        else if (difference < 0)
+        {
+          // The consumer has not freed this cell yet
+          return false;
+        }
+        else
+        {
+          // Another producer claimed it first
+          position = m_writePosition.load(std::memory_order_relaxed);
+        }
+      }
+
+      fill(cell->value);
+      cell->sequence.store(position + 1, std::memory_order_release);
+      return true;
+    }
+
+    // Calls consume(T&) on the oldest value and frees its cell, returns false
+    // if there is nothing ready. Only one thread may pop.
+    template<class TConsume>
+    bool try_pop(TConsume&& consume)
+    {
+      const size_t position = m_readPosition.load(std::memory_order_relaxed);
+      Cell& cell = m_cells[position & m_mask];
+      const size_t sequence = cell.sequence.load(std::memory_order_acquire);
+
+      // Either empty or the producer that claimed it is still writing
+      if (sequence != position + 1)
+      {
+        return false;
+      }
+
+      consume(cell.value);
+      cell.sequence.store(position + m_mask + 1, std::memory_order_release);
+      m_readPosition.store(position + 1, std::memory_order_release);
+      return true;
+    }
+
+    // Number of values pushed so far, including ones not popped yet
+    size_t pushed_count() const { return m_writePosition.load(std::memory_order_acquire); }
+
+    // Number of values popped so far
+    size_t popped_count() const { return m_readPosition.load(std::memory_order_acquire); }
+
+    size_t capacity() const { return m_mask + 1; }
+
+  private:
+    struct Cell
+    {
+      std::atomic<size_t> sequence;
+      T value;
+    };
+
+    std::unique_ptr<Cell[]> m_cells;
+    const size_t m_mask;
+
+    // The positions sit on their own cache lines so producers and the
+    // consumer do not slow each other down
+    UInt8 m_padding0[CacheLineSize];
+    std::atomic<size_t> m_writePosition;
+    UInt8 m_padding1[CacheLineSize];
+    std::atomic<size_t> m_readPosition;
+    UInt8 m_padding2[CacheLineSize];
+  };
+}
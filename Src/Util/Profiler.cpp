@@ -0,0 +1,255 @@
+/******************************************************************************
+File: Profiler.cpp
+Created: 10/18/2026 10:14:51 AM
+Copyright (c) 2017 Turn Tactics
+
+Permission is hereby granted, free of charge, to any person obtaining a copy
+of this software and associated documentation files (the "Software"), to deal
+in the Software without restriction, including without limitation the rights
+to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+copies of the Software, and to permit persons to whom the Software is
+furnished to do so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in
+all copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+SOFTWARE.
+
+Purpose: Defines the frame profiler that records scoped timing zones and named
+         counters per thread and exports them as a Chrome trace.
+
+Author: James Womack
+
+********************************************************************************/
+#include "Profiler.h"
+
+#include <atomic>
+#include <fstream>
+#include <iomanip>
+#include <memory>
+#include <mutex>
+
+namespace lse
+{
+  namespace profiler
+  {
+    namespace
+    {
+      enum class EventType : UInt8
+      {
+        Zone,
+        Counter
+      };
+
+      struct Event
+      {
+        const char* name;
+        Uint64 start;
+        Uint64 end;
+        Float64 value;
+        EventType type;
+      };
+
+      // Ring of the most recent events of one thread. Only the owning thread
+      // writes, the busy flag keeps an export from reading a half written
+      // event and is uncontended otherwise.
+      struct ThreadBuffer
+      {
+        UInt32 threadId = 0;
+        const char* name = nullptr;
+        std::atomic_flag busy = ATOMIC_FLAG_INIT;
+        Uint64 written = 0;
+        std::unique_ptr<Event[]> events;
+      };
+
+      struct Registry
+      {
+        std::mutex mutex;
+        // Buffers are kept after their thread exits so its events can still
+        // be exported
+        containers::Vector<std::unique_ptr<ThreadBuffer>> threads;
+        Uint64 frames[FramesKept];
+        Uint64 frameCount = 0;
+        Uint64 origin = SDL_GetPerformanceCounter();
+      };
+
+      Registry& registry()
+      {
+        static Registry s_registry;
+        return s_registry;
+      }
+
+      thread_local ThreadBuffer* t_buffer = nullptr;
+
+      ThreadBuffer& thread_buffer()
+      {
+        if (t_buffer == nullptr)
+        {
+          Registry& reg = registry();
+          std::lock_guard<std::mutex> lock(reg.mutex);
+
+          std::unique_ptr<ThreadBuffer> buffer(new ThreadBuffer());
+          buffer->threadId = static_cast<UInt32>(reg.threads.size());
+          buffer->events.reset(new Event[EventsPerThread]);
+          t_buffer = buffer.get();
+          reg.threads.push_back(std::move(buffer));
+        }
+
+        return *t_buffer;
+      }
+
+      void push_event(const Event& e)
+      {
+        ThreadBuffer& buffer = thread_buffer();
+
+        while (buffer.busy.test_and_set(std::memory_order_acquire))
+        {
+        }
+
+        buffer.events[buffer.written % EventsPerThread] = e;
+        ++buffer.written;
+
+        buffer.busy.clear(std::memory_order_release);
+      }
+
+      // Writes a JSON string with quotes and escapes
+      void write_string(std::ostream& out, const char* text)
+      {
+        out << '"';
+        for (const char* c = text; *c != '\0'; ++c)
+        {
+          if (*c == '"' || *c == '\\')
+          {
+            out << '\\' << *c;
+          }
+          else if (static_cast<UChar>(*c) < 0x20)
+          {
+            out << "\\u" << std::hex << std::setw(4) << std::setfill('0')
+              << static_cast<UInt32>(static_cast<UChar>(*c)) << std::dec << std::setfill(' ');
+          }
+          else
+          {
+            out << *c;
+          }
+        }
+        out << '"';
+      }
+    }
+
+    void set_thread_name(const char* name)
+    {
+      ThreadBuffer& buffer = thread_buffer();
+      std::lock_guard<std::mutex> lock(registry().mutex);
+      buffer.name = name;
+    }
+
+    void record_zone(const char* name, Uint64 start, Uint64 end)
+    {
+      push_event(Event{ name, start, end, 0.0, EventType::Zone });
+    }
+
+    void record_counter(const char* name, Float64 value)
+    {
+      const Uint64 now = SDL_GetPerformanceCounter();
+      push_event(Event{ name, now, now, value, EventType::Counter });
+    }
+
+    void frame_mark()
+    {
+      Registry& reg = registry();
+      const Uint64 now = SDL_GetPerformanceCounter();
+
+      std::lock_guard<std::mutex> lock(reg.mutex);
+      reg.frames[reg.frameCount % FramesKept] = now;
+      ++reg.frameCount;
+    }
+
+    bool export_chrome_trace(const String& path, UInt32 lastFrames)
+    {
+      std::ofstream out(path, std::ios::out | std::ios::trunc);
+      if (!out)
+      {
+        return false;
+      }
+
+      Registry& reg = registry();
+      std::lock_guard<std::mutex> lock(reg.mutex);
+
+      // Events that started before the cutoff belong to older frames
+      Uint64 cutoff = 0;
+      if (lastFrames > 0 && reg.frameCount > 0)
+      {
+        const Uint64 kept = std::min<Uint64>(std::min<Uint64>(lastFrames, reg.frameCount), FramesKept);
+        cutoff = reg.frames[(reg.frameCount - kept) % FramesKept];
+      }
+
+      const Float64 microsPerTick = 1000000.0 / SDL_GetPerformanceFrequency();
+
+      containers::Vector<Event> events;
+      bool first = true;
+
+      out << std::fixed << std::setprecision(3);
+      out << "{\"traceEvents\":[\n";
+
+      for (const std::unique_ptr<ThreadBuffer>& thread : reg.threads)
+      {
+        // Copy the ring out so the thread is held up as little as possible
+        while (thread->busy.test_and_set(std::memory_order_acquire))
+        {
+        }
+
+        const Uint64 count = std::min<Uint64>(thread->written, EventsPerThread);
+        events.clear();
+        for (Uint64 i = thread->written - count; i < thread->written; ++i)
+        {
+          events.push_back(thread->events[i % EventsPerThread]);
+        }
+
+        thread->busy.clear(std::memory_order_release);
+
+        if (thread->name != nullptr)
+        {
+          out << (first ? "" : ",\n") << "{\"ph\":\"M\",\"name\":\"thread_name\",\"pid\":0,\"tid\":"
+            << thread->threadId << ",\"args\":{\"name\":";
+          write_string(out, thread->name);
+          out << "}}";
+          first = false;
+        }
+
+        for (const Event& e : events)
+        {
+          if (e.start < cutoff || e.start < reg.origin)
+          {
+            continue;
+          }
+
+          out << (first ? "" : ",\n") << "{\"name\":";
+          write_string(out, e.name);
+          out << ",\"pid\":0,\"tid\":" << thread->threadId
+            << ",\"ts\":" << static_cast<Float64>(e.start - reg.origin) * microsPerTick;
+
+          if (e.type == EventType::Zone)
+          {
+            out << ",\"ph\":\"X\",\"dur\":" << static_cast<Float64>(e.end - e.start) * microsPerTick << "}";
+          }
+          else
+          {
+            out << ",\"ph\":\"C\",\"args\":{\"value\":" << e.value << "}}";
+          }
+
+          first = false;
+        }
+      }
+
+      out << "\n]}\n";
+      out.close();
+      return !out.fail();
+    }
+  }
+}
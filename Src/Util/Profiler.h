@@ -0,0 +1,116 @@
+/******************************************************************************
+File: Profiler.h
+Created: 10/18/2026 10:14:51 AM
+Copyright (c) 2017 Turn Tactics
+
+Permission is hereby granted, free of charge, to any person obtaining a copy
+of this software and associated documentation files (the "Software"), to deal
+in the Software without restriction, including without limitation the rights
+to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+copies of the Software, and to permit persons to whom the Software is
+furnished to do so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in
+all copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+SOFTWARE.
+
+Purpose: Defines the frame profiler that records scoped timing zones and named
+         counters per thread and exports them as a Chrome trace.
+
+Author: James Womack
+
+********************************************************************************/
+#pragma once
+
+#include "../Common.h"
+
+#include <SDL.h>
+
+// The profiler is compiled into debug builds only, define LSE_PROFILER as 1
+// or 0 to force it on or off
+#ifndef LSE_PROFILER
+#ifdef NDEBUG
+#define LSE_PROFILER 0
+#else
+#define LSE_PROFILER 1
+#endif
+#endif
+
+namespace lse
+{
+  namespace profiler
+  {
+    // Number of events each thread keeps before the oldest are overwritten
+    const UInt32 EventsPerThread = 1 << 16;
+
+    // Number of frame boundaries kept for exporting the last N frames
+    const UInt32 FramesKept = 1024;
+
+    // Names the calling thread in exported traces, the name must outlive the
+    // profiler (a string literal)
+    void set_thread_name(const char* name);
+
+    // Records a zone that ran from start to end (performance counter ticks)
+    void record_zone(const char* name, Uint64 start, Uint64 end);
+
+    // Records the value of a named counter at this moment
+    void record_counter(const char* name, Float64 value);
+
+    // Marks the start of a new frame
+    void frame_mark();
+
+    // Writes every event still held to a Chrome trace JSON file that can be
+    // opened in chrome://tracing or Perfetto. When lastFrames is not zero only
+    // events from that many of the most recent frames are written. Returns
+    // false if the file could not be written.
+    bool export_chrome_trace(const String& path, UInt32 lastFrames = 0);
+
+    // Times the scope it is declared in
+    class ScopedZone
+    {
+    public:
+      explicit ScopedZone(const char* name) :
+        m_name(name), m_start(SDL_GetPerformanceCounter())
+      {
+      }
+
+      ~ScopedZone()
+      {
+        record_zone(m_name, m_start, SDL_GetPerformanceCounter());
+      }
+
+      ScopedZone(const ScopedZone&) = delete;
+      ScopedZone& operator=(const ScopedZone&) = delete;
+
+    private:
+      const char* m_name;
+      Uint64 m_start;
+    };
+  }
+}
+
+#define LSE_PROFILE_CONCAT_INNER(a, b) a##b
+#define LSE_PROFILE_CONCAT(a, b) LSE_PROFILE_CONCAT_INNER(a, b)
+
+#if LSE_PROFILER
+// Times the rest of the enclosing scope under the given name (a string literal)
+#define LSE_PROFILE_ZONE(name) ::lse::profiler::ScopedZone LSE_PROFILE_CONCAT(lseProfileZone, __LINE__)(name)
+// Records a named counter value
+#define LSE_PROFILE_COUNTER(name, value) ::lse::profiler::record_counter(name, static_cast<Float64>(value))
+// Marks the start of a new frame
+#define LSE_PROFILE_FRAME() ::lse::profiler::frame_mark()
+// Names the calling thread in traces
+#define LSE_PROFILE_THREAD(name) ::lse::profiler::set_thread_name(name)
+#else
+#define LSE_PROFILE_ZONE(name)
+#define LSE_PROFILE_COUNTER(name, value) do { } while (0)
+#define LSE_PROFILE_FRAME() do { } while (0)
+#define LSE_PROFILE_THREAD(name) do { } while (0)
+#endif
@@ -0,0 +1,105 @@
+/******************************************************************************
+File: StringId.cpp
+Created: 10/22/2026 9:26:44 AM
+Copyright (c) 2017 Turn Tactics
+
+Permission is hereby granted, free of charge, to any person obtaining a copy
+of this software and associated documentation files (the "Software"), to deal
+in the Software without restriction, including without limitation the rights
+to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+copies of the Software, and to permit persons to whom the Software is
+furnished to do so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in
+all copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+SOFTWARE.
+
+Purpose: Defines StringId, a 32 bit hash standing in for a string so names can
+         be compared and used as keys as cheaply as integers, with the
+         hashing done at compile time for literals.
+
+Author: James Womack
+
+********************************************************************************/
+#include "StringId.h"
+#include "Logger.h"
+
+#include <cassert>
+#include <memory>
+#include <mutex>
+
+namespace lse
+{
+  namespace
+  {
+#if LSE_STRING_ID_NAMES
+    struct NameTable
+    {
+      std::mutex mutex;
+      // Strings are boxed so the pointers handed out by name stay put while
+      // the table grows
+      containers::UnorderedMap<StringId, std::unique_ptr<String>> names;
+    };
+
+    NameTable& name_table()
+    {
+      static NameTable s_table;
+      return s_table;
+    }
+#endif
+  }
+
+  StringId intern(const char* str, size_t length)
+  {
+    const StringId id = make_string_id(str, length);
+
+#if LSE_STRING_ID_NAMES
+    NameTable& table = name_table();
+    std::lock_guard<std::mutex> lock(table.mutex);
+
+    const auto it = table.names.find(id);
+    if (it == table.names.end())
+    {
+      table.names.emplace(id, std::unique_ptr<String>(new String(str, length)));
+    }
+    else if (it->second->compare(0, String::npos, str, length) != 0)
+    {
+      LSE_LOG_ERROR(General, "String ids of \"%s\" and \"%s\" collide!", *it->second, String(str, length));
+      logger::flush();
+      assert(false);
+    }
+#endif
+
+    return id;
+  }
+
+  StringId intern(const String& str)
+  {
+    return intern(str.data(), str.size());
+  }
+
+  const char* name(StringId id)
+  {
+#if LSE_STRING_ID_NAMES
+    NameTable& table = name_table();
+    std::lock_guard<std::mutex> lock(table.mutex);
+
+    const auto it = table.names.find(id);
+    if (it != table.names.end())
+    {
+      return it->second->c_str();
+    }
+#else
+    (void)id;
+#endif
+
+    return "<unnamed string id>";
+  }
+}
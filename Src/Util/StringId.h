@@ -0,0 +1,122 @@
+/******************************************************************************
+File: StringId.h
+Created: 10/22/2026 9:26:44 AM
+Copyright (c) 2017 Turn Tactics
+
+Permission is hereby granted, free of charge, to any person obtaining a copy
+of this software and associated documentation files (the "Software"), to deal
+in the Software without restriction, including without limitation the rights
+to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+copies of the Software, and to permit persons to whom the Software is
+furnished to do so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in
+all copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+SOFTWARE.
+
+Purpose: Defines StringId, a 32 bit hash standing in for a string so names can
+         be compared and used as keys as cheaply as integers, with the
+         hashing done at compile time for literals.
+
+Author: James Womack
+
+********************************************************************************/
+#pragma once
+
+#include "../Common.h"
+
+#include <cstddef>
+#include <functional>
+
+// Debug builds remember the string behind every interned id so it can be
+// printed, define LSE_STRING_ID_NAMES as 1 or 0 to force it on or off
+#ifndef LSE_STRING_ID_NAMES
+#ifdef NDEBUG
+#define LSE_STRING_ID_NAMES 0
+#else
+#define LSE_STRING_ID_NAMES 1
+#endif
+#endif
+
+namespace lse
+{
+  // 32 bit FNV-1a hash, usable at compile time
+  constexpr UInt32 fnv1a(const char* str, size_t length)
+  {
+    UInt32 hash = 2166136261u;
+    for (size_t i = 0; i < length; ++i)
+    {
+      hash ^= static_cast<UInt8>(str[i]);
+      hash *= 16777619u;
+    }
+
+    return hash;
+  }
+
+  // A string reduced to its hash. Equal strings always give equal ids, and
+  // the interner reports in debug builds if two different strings ever
+  // collide. Ids made from the same text at compile time with _sid and at
+  // runtime with intern are the same.
+  class StringId
+  {
+  public:
+    constexpr StringId() : m_value(0) {}
+    constexpr explicit StringId(UInt32 value) : m_value(value) {}
+
+    constexpr UInt32 value() const { return m_value; }
+
+    // Returns if the id was made from a string, the empty string included
+    constexpr bool is_valid() const { return m_value != 0; }
+
+    constexpr bool operator==(StringId other) const { return m_value == other.m_value; }
+    constexpr bool operator!=(StringId other) const { return m_value != other.m_value; }
+    constexpr bool operator<(StringId other) const { return m_value < other.m_value; }
+
+  private:
+    UInt32 m_value;
+  };
+
+  // Makes the id of a string at compile time, no name is recorded
+  constexpr StringId make_string_id(const char* str, size_t length)
+  {
+    // Zero is kept for the invalid id
+    const UInt32 hash = fnv1a(str, length);
+    return StringId(hash != 0 ? hash : 1);
+  }
+
+  // Makes the id of a string and, in debug builds, records the string for
+  // name. Safe to call from any thread.
+  StringId intern(const char* str, size_t length);
+  StringId intern(const String& str);
+
+  // Returns the string an id was interned from, or a placeholder when names
+  // are compiled out or the id was only ever made at compile time. The
+  // pointer stays valid for the rest of the program.
+  const char* name(StringId id);
+
+  inline namespace literals
+  {
+    // "Res/loaded.png"_sid is the id of the string, computed at compile time
+    constexpr StringId operator"" _sid(const char* str, size_t length)
+    {
+      return make_string_id(str, length);
+    }
+  }
+}
+
+namespace std
+{
+  template<>
+  struct hash<lse::StringId>
+  {
+    // Already a good hash
+    size_t operator()(lse::StringId id) const { return id.value(); }
+  };
+}
@@ -0,0 +1,571 @@
+/******************************************************************************
+File: Telemetry.cpp
+Created: 10/23/2026 3:27:52 PM
+Copyright (c) 2017 Turn Tactics
+
+Permission is hereby granted, free of charge, to any person obtaining a copy
+of this software and associated documentation files (the "Software"), to deal
+in the Software without restriction, including without limitation the rights
+to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+copies of the Software, and to permit persons to whom the Software is
+furnished to do so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in
+all copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+SOFTWARE.
+
+Purpose: Records named engine counters every few frames and streams them to a
+         CSV or binary file on a background thread.
+
+Author: James Womack
+
+********************************************************************************/
+#include "Telemetry.h"
+#include "Logger.h"
+#include "MpscQueue.h"
+
+#include <algorithm>
+#include <atomic>
+#include <chrono>
+#include <cmath>
+#include <condition_variable>
+#include <cstring>
+#include <fstream>
+#include <iterator>
+#include <limits>
+#include <memory>
+#include <mutex>
+#include <stdio.h>
+#include <thread>
+
+namespace lse
+{
+  namespace telemetry
+  {
+    namespace
+    {
+      // Layout of a binary telemetry file. A header is followed by chunks,
+      // each starting with a ChunkType byte. All values are little endian.
+      //   Header:  Magic, UInt32 version
+      //   Counter: UInt32 ID, UInt16 length, name. Written before the first
+      //            block that has the column.
+      //   Block:   UInt32 rows, UInt32 columns, Uint64 frame numbers,
+      //            Float64 seconds, then each column's Float64 values. Values
+      //            sampled before their counter existed are NaN.
+      //   Dropped: UInt32 samples dropped since the last one
+      const char Magic[8] = "LSETLM1";
+      const UInt32 Version = 1;
+
+      enum class ChunkType : UInt8
+      {
+        Counter = 'C',
+        Block = 'B',
+        Dropped = 'D'
+      };
+
+      // Every counter registered when the sample was taken
+      struct Sample
+      {
+        Uint64 frame;
+        Float64 seconds;
+        UInt32 count;
+        Float64 values[MaxCounters];
+      };
+
+      struct State
+      {
+        TelemetrySettings settings;
+        std::unique_ptr<MpscQueue<Sample>> queue;
+        std::ofstream file;
+        std::thread writer;
+        std::atomic<bool> running{ false };
+        Uint64 origin = 0;
+        Uint64 frequency = 1;
+        Uint64 frame = 0;
+        std::atomic<Uint64> dropped{ 0 };
+
+        // Registered counters. Read without locking, the count is published
+        // after the name.
+        std::mutex counterMutex;
+        std::atomic<UInt32> counterCount{ 0 };
+        std::atomic<const char*> names[MaxCounters] = {};
+        std::atomic<Float64> values[MaxCounters] = {};
+
+        // Wakes the writer early to stop
+        std::mutex mutex;
+        std::condition_variable wake;
+        bool quit = false;
+      };
+
+      State& state()
+      {
+        static State s_state;
+        return s_state;
+      }
+
+      template<class T>
+      void append_value(String& out, const T& value)
+      {
+        out.append(reinterpret_cast<const char*>(&value), sizeof(T));
+      }
+
+      template<class T>
+      bool read_value(const char*& cursor, const char* end, T& value)
+      {
+        if (static_cast<size_t>(end - cursor) < sizeof(T))
+        {
+          return false;
+        }
+
+        std::memcpy(&value, cursor, sizeof(T));
+        cursor += sizeof(T);
+        return true;
+      }
+
+      void append_csv_header(String& out, const containers::Vector<String>& names, UInt32 columns)
+      {
+        out.append("frame,seconds");
+        for (UInt32 column = 0; column < columns; ++column)
+        {
+          out.push_back(',');
+          out.append(column < names.size() ? names[column] : "counter" + std::to_string(column));
+        }
+        out.push_back('\n');
+      }
+
+      void append_csv_row(String& out, Uint64 frame, Float64 seconds, const Float64* values, UInt32 columns)
+      {
+        char text[64];
+        int length = snprintf(text, sizeof(text), "%llu,%.6f", static_cast<unsigned long long>(frame), seconds);
+        out.append(text, static_cast<size_t>(std::max(length, 0)));
+
+        for (UInt32 column = 0; column < columns; ++column)
+        {
+          out.push_back(',');
+
+          // Left empty before the counter existed
+          const Float64 value = values[column];
+          if (!std::isnan(value))
+          {
+            length = snprintf(text, sizeof(text), "%.15g", value);
+            out.append(text, static_cast<size_t>(std::max(length, 0)));
+          }
+        }
+        out.push_back('\n');
+      }
+
+      void writer_main()
+      {
+        State& st = state();
+        const bool binary = st.settings.binary;
+        containers::Vector<Sample> block;
+        block.reserve(st.settings.queueCapacity);
+        containers::Vector<String> names;
+        String out;
+        Uint64 reportedDrops = 0;
+
+        // CSV gets a single header with the counters registered by the first
+        // sample, later counters are only in binary files
+        bool headerWritten = false;
+        UInt32 headerColumns = 0;
+        UInt32 reportedColumns = 0;
+
+        if (binary)
+        {
+          out.append(Magic, sizeof(Magic));
+          append_value(out, Version);
+        }
+
+        for (;;)
+        {
+          bool quit;
+          {
+            std::lock_guard<std::mutex> lock(st.mutex);
+            quit = st.quit;
+          }
+
+          block.clear();
+          while (st.queue->try_pop([&block](Sample& sample) { block.push_back(sample); }))
+          {
+          }
+
+          UInt32 columns = 0;
+          for (const Sample& sample : block)
+          {
+            columns = std::max(columns, sample.count);
+          }
+
+          // Name the counters that appeared since the last block
+          while (names.size() < columns)
+          {
+            const UInt32 id = static_cast<UInt32>(names.size());
+            names.emplace_back(st.names[id].load(std::memory_order_relaxed));
+
+            if (binary)
+            {
+              const UInt16 length = static_cast<UInt16>(std::min<size_t>(names.back().size(), 0xFFFF));
+              out.push_back(static_cast<char>(ChunkType::Counter));
+              append_value(out, id);
+              append_value(out, length);
+              out.append(names.back().data(), length);
+            }
+          }
+
+          if (!block.empty() && binary)
+          {
+            out.push_back(static_cast<char>(ChunkType::Block));
+            append_value(out, static_cast<UInt32>(block.size()));
+            append_value(out, columns);
+
+            for (const Sample& sample : block)
+            {
+              append_value(out, sample.frame);
+            }
+
+            for (const Sample& sample : block)
+            {
+              append_value(out, sample.seconds);
+            }
+
+            for (UInt32 column = 0; column < columns; ++column)
+            {
+              for (const Sample& sample : block)
+              {
+                append_value(out, column < sample.count ? sample.values[column] : std::numeric_limits<Float64>::quiet_NaN());
+              }
+            }
+          }
+          else
+          {
+            for (const Sample& sample : block)
+            {
+              if (!headerWritten)
+              {
+                headerWritten = true;
+                headerColumns = sample.count;
+                reportedColumns = sample.count;
+                append_csv_header(out, names, headerColumns);
+              }
+
+              if (sample.count > reportedColumns)
+              {
+                for (UInt32 column = reportedColumns; column < sample.count; ++column)
+                {
+                  LSE_LOG_WARNING(General, "Telemetry counter %s was added after the CSV header, record binary telemetry to keep it",
+                    names[column]);
+                }
+                reportedColumns = sample.count;
+              }
+
+              append_csv_row(out, sample.frame, sample.seconds, sample.values, headerColumns);
+            }
+          }
+
+          // CSV has nowhere to put it, stop reports the total instead
+          const Uint64 dropped = st.dropped.load(std::memory_order_relaxed);
+          if (dropped != reportedDrops && binary)
+          {
+            out.push_back(static_cast<char>(ChunkType::Dropped));
+            append_value(out, static_cast<UInt32>(dropped - reportedDrops));
+            reportedDrops = dropped;
+          }
+
+          if (!out.empty())
+          {
+            st.file.write(out.data(), static_cast<std::streamsize>(out.size()));
+            st.file.flush();
+            out.clear();
+          }
+
+          if (quit)
+          {
+            return;
+          }
+
+          std::unique_lock<std::mutex> lock(st.mutex);
+          st.wake.wait_for(lock, std::chrono::milliseconds(st.settings.flushIntervalMs), [&st]() { return st.quit; });
+        }
+      }
+    }
+
+    bool start(const TelemetrySettings& settings)
+    {
+      State& st = state();
+      if (st.running.load())
+      {
+        stop();
+      }
+
+      st.file.open(settings.path, std::ios::out | std::ios::trunc | std::ios::binary);
+      if (!st.file.is_open())
+      {
+        LSE_LOG_ERROR(General, "Unable to open telemetry file %s!", settings.path);
+        return false;
+      }
+
+      st.settings = settings;
+      st.settings.sampleInterval = std::max(settings.sampleInterval, 1u);
+      st.queue.reset(new MpscQueue<Sample>(settings.queueCapacity));
+      st.origin = SDL_GetPerformanceCounter();
+      st.frequency = SDL_GetPerformanceFrequency();
+      st.frame = 0;
+      st.dropped.store(0);
+
+      // Counters left from an earlier session stay empty until set again
+      for (std::atomic<Float64>& value : st.values)
+      {
+        value.store(std::numeric_limits<Float64>::quiet_NaN(), std::memory_order_relaxed);
+      }
+
+      st.quit = false;
+      st.writer = std::thread(writer_main);
+      st.running.store(true, std::memory_order_release);
+      return true;
+    }
+
+    void stop()
+    {
+      State& st = state();
+      if (!st.running.load())
+      {
+        return;
+      }
+
+      st.running.store(false, std::memory_order_release);
+      {
+        std::lock_guard<std::mutex> lock(st.mutex);
+        st.quit = true;
+      }
+      st.wake.notify_one();
+      st.writer.join();
+      st.file.close();
+
+      const Uint64 dropped = st.dropped.load();
+      if (dropped > 0)
+      {
+        LSE_LOG_WARNING(General, "Telemetry queue was full, dropped %llu samples", dropped);
+      }
+    }
+
+    bool is_running()
+    {
+      return state().running.load(std::memory_order_acquire);
+    }
+
+    CounterId register_counter(const char* name)
+    {
+      State& st = state();
+      std::lock_guard<std::mutex> lock(st.counterMutex);
+
+      // Counters set from several places share a column
+      const UInt32 count = st.counterCount.load(std::memory_order_relaxed);
+      for (UInt32 id = 0; id < count; ++id)
+      {
+        if (std::strcmp(st.names[id].load(std::memory_order_relaxed), name) == 0)
+        {
+          return id;
+        }
+      }
+
+      if (count == MaxCounters)
+      {
+        LSE_LOG_WARNING(General, "Too many telemetry counters, %s is ignored", name);
+        return MaxCounters;
+      }
+
+      st.names[count].store(name, std::memory_order_relaxed);
+      st.values[count].store(std::numeric_limits<Float64>::quiet_NaN(), std::memory_order_relaxed);
+      st.counterCount.store(count + 1, std::memory_order_release);
+      return count;
+    }
+
+    void set(CounterId counter, Float64 value)
+    {
+      if (counter < MaxCounters)
+      {
+        state().values[counter].store(value, std::memory_order_relaxed);
+      }
+    }
+
+    void add(CounterId counter, Float64 value)
+    {
+      if (counter < MaxCounters)
+      {
+        std::atomic<Float64>& total = state().values[counter];
+        Float64 current = total.load(std::memory_order_relaxed);
+        while (!total.compare_exchange_weak(current, std::isnan(current) ? value : current + value,
+          std::memory_order_relaxed))
+        {
+        }
+      }
+    }
+
+    void end_frame()
+    {
+      State& st = state();
+      if (!st.running.load(std::memory_order_acquire) || ++st.frame % st.settings.sampleInterval != 0)
+      {
+        return;
+      }
+
+      const Uint64 now = SDL_GetPerformanceCounter();
+      const bool pushed = st.queue->try_push([&st, now](Sample& sample)
+      {
+        sample.frame = st.frame;
+        sample.seconds = static_cast<Float64>(now - st.origin) / st.frequency;
+        sample.count = st.counterCount.load(std::memory_order_acquire);
+        for (UInt32 id = 0; id < sample.count; ++id)
+        {
+          sample.values[id] = st.values[id].load(std::memory_order_relaxed);
+        }
+      });
+
+      if (!pushed)
+      {
+        st.dropped.fetch_add(1, std::memory_order_relaxed);
+      }
+    }
+
+    Uint64 dropped_count()
+    {
+      return state().dropped.load(std::memory_order_relaxed);
+    }
+
+    bool convert_to_csv(const String& path, std::ostream& out)
+    {
+      std::ifstream file(path, std::ios::in | std::ios::binary);
+      if (!file.is_open())
+      {
+        printf("Unable to open telemetry file %s!\n", path.c_str());
+        return false;
+      }
+
+      const String data((std::istreambuf_iterator<char>(file)), std::istreambuf_iterator<char>());
+      const char* cursor = data.data();
+      const char* end = data.data() + data.size();
+
+      char magic[sizeof(Magic)] = {};
+      UInt32 version = 0;
+      if (!read_value(cursor, end, magic) || std::memcmp(magic, Magic, sizeof(Magic)) != 0 ||
+        !read_value(cursor, end, version) || version != Version)
+      {
+        printf("%s is not a binary telemetry file!\n", path.c_str());
+        return false;
+      }
+
+      // Blocks are found first so the one header has every column
+      struct Block
+      {
+        UInt32 rows;
+        UInt32 columns;
+        const char* data;
+      };
+
+      containers::Vector<String> names;
+      containers::Vector<Block> blocks;
+      UInt32 columns = 0;
+
+      while (cursor < end)
+      {
+        UInt8 type = 0;
+        read_value(cursor, end, type);
+
+        bool valid = false;
+        switch (static_cast<ChunkType>(type))
+        {
+        case ChunkType::Counter:
+        {
+          UInt32 id = 0;
+          UInt16 length = 0;
+          valid = read_value(cursor, end, id) && read_value(cursor, end, length) &&
+            id < MaxCounters && static_cast<size_t>(end - cursor) >= length;
+          if (valid)
+          {
+            names.resize(std::max<size_t>(names.size(), id + 1));
+            names[id].assign(cursor, length);
+            cursor += length;
+          }
+          break;
+        }
+        case ChunkType::Block:
+        {
+          Block block;
+          valid = read_value(cursor, end, block.rows) && read_value(cursor, end, block.columns) &&
+            block.columns <= MaxCounters &&
+            static_cast<size_t>(end - cursor) >= static_cast<size_t>(block.rows) * (2 + block.columns) * sizeof(Float64);
+          if (valid)
+          {
+            block.data = cursor;
+            cursor += static_cast<size_t>(block.rows) * (2 + block.columns) * sizeof(Float64);
+            columns = std::max(columns, block.columns);
+            blocks.push_back(block);
+          }
+          break;
+        }
+        case ChunkType::Dropped:
+        {
+          UInt32 count = 0;
+          valid = read_value(cursor, end, count);
+          if (valid)
+          {
+            printf("%u samples were dropped while recording\n", count);
+          }
+          break;
+        }
+        }
+
+        if (!valid)
+        {
+          printf("%s ends with a damaged chunk, stopping there\n", path.c_str());
+          break;
+        }
+      }
+
+      String text;
+      append_csv_header(text, names, columns);
+      out.write(text.data(), static_cast<std::streamsize>(text.size()));
+      text.clear();
+
+      // Columns a block does not have are left empty
+      Float64 row[MaxCounters];
+      for (const Block& block : blocks)
+      {
+        const char* frames = block.data;
+        const char* seconds = frames + block.rows * sizeof(Uint64);
+        const char* values = seconds + block.rows * sizeof(Float64);
+
+        for (UInt32 index = 0; index < block.rows; ++index)
+        {
+          Uint64 frame;
+          Float64 time;
+          std::memcpy(&frame, frames + index * sizeof(Uint64), sizeof(frame));
+          std::memcpy(&time, seconds + index * sizeof(Float64), sizeof(time));
+          for (UInt32 column = 0; column < columns; ++column)
+          {
+            row[column] = std::numeric_limits<Float64>::quiet_NaN();
+            if (column < block.columns)
+            {
+              std::memcpy(&row[column], values + (static_cast<size_t>(column) * block.rows + index) * sizeof(Float64),
+                sizeof(Float64));
+            }
+          }
+
+          append_csv_row(text, frame, time, row, columns);
+        }
+
+        out.write(text.data(), static_cast<std::streamsize>(text.size()));
+        text.clear();
+      }
+
+      out.flush();
+      return true;
+    }
+  }
+}
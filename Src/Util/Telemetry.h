@@ -0,0 +1,125 @@
+/******************************************************************************
+File: Telemetry.h
+Created: 10/23/2026 3:27:52 PM
+Copyright (c) 2017 Turn Tactics
+
+Permission is hereby granted, free of charge, to any person obtaining a copy
+of this software and associated documentation files (the "Software"), to deal
+in the Software without restriction, including without limitation the rights
+to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+copies of the Software, and to permit persons to whom the Software is
+furnished to do so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in
+all copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+SOFTWARE.
+
+Purpose: Records named engine counters every few frames and streams them to a
+         CSV or binary file on a background thread.
+
+Author: James Womack
+
+********************************************************************************/
+#pragma once
+
+#include "../Common.h"
+
+#include <SDL.h>
+#include <ostream>
+
+namespace lse
+{
+  struct TelemetrySettings
+  {
+    // File the samples are written to, truncated on start
+    String path = "telemetry.csv";
+
+    // Write blocks of samples column by column as raw numbers instead of
+    // CSV. Smaller and cheaper to write, convert with --telemetry-csv.
+    bool binary = false;
+
+    // Frames between samples, 1 samples every frame
+    UInt32 sampleInterval = 1;
+
+    // Samples that can wait to be written, must be a power of two. When it
+    // fills up new samples are dropped and counted rather than blocking.
+    UInt32 queueCapacity = 256;
+
+    // Longest the writer thread sleeps before writing samples (ms)
+    UInt32 flushIntervalMs = 250;
+  };
+
+  namespace telemetry
+  {
+    // Counters that can be registered, each is one column
+    const UInt32 MaxCounters = 64;
+
+    // Identifies a registered counter
+    using CounterId = UInt32;
+
+    // Opens the file and starts the writer thread, returns false if the
+    // file could not be opened. Start and stop from the thread calling
+    // end_frame.
+    bool start(const TelemetrySettings& settings = TelemetrySettings());
+
+    // Writes every queued sample and stops the writer thread
+    void stop();
+
+    // Returns if samples are being recorded
+    bool is_running();
+
+    // Adds a column and returns its ID, the name must live for the whole
+    // program (a literal). A CSV file has one header, written with the first
+    // sample, so register every counter before start. Later columns are left
+    // out of the CSV with a warning but kept in binary files. Once
+    // MaxCounters are in use the counter is ignored.
+    CounterId register_counter(const char* name);
+
+    // Sets a counter, the value is kept for every sample until it changes.
+    // Counters are empty in samples until first set. Safe from any thread.
+    void set(CounterId counter, Float64 value);
+
+    // Adds to a counter, for running totals. Safe from any thread.
+    void add(CounterId counter, Float64 value);
+
+    // Counts a frame and, every sampleInterval frames, queues the current
+    // value of every counter as one sample
+    void end_frame();
+
+    // Number of samples dropped because the queue was full
+    Uint64 dropped_count();
+
+    // Turns a binary telemetry file into CSV with one header holding every
+    // column, returns false if the file could not be read or is not telemetry
+    bool convert_to_csv(const String& path, std::ostream& out);
+  }
+}
+
+// Set or add to a counter by name, registered the first time the line runs.
+// The name must be a string literal. Nothing is evaluated while telemetry
+// is not running.
+#define LSE_TELEMETRY_SET(name, value) \
+  do \
+  { \
+    if (::lse::telemetry::is_running()) \
+    { \
+      static const ::lse::telemetry::CounterId lseTelemetryCounter = ::lse::telemetry::register_counter("" name); \
+      ::lse::telemetry::set(lseTelemetryCounter, static_cast<Float64>(value)); \
+    } \
+  } while (0)
+#define LSE_TELEMETRY_ADD(name, value) \
+  do \
+  { \
+    if (::lse::telemetry::is_running()) \
+    { \
+      static const ::lse::telemetry::CounterId lseTelemetryCounter = ::lse::telemetry::register_counter("" name); \
+      ::lse::telemetry::add(lseTelemetryCounter, static_cast<Float64>(value)); \
+    } \
+  } while (0)
@@ -0,0 +1,102 @@
+/******************************************************************************
+File: TripleBuffer.h
+Created: 10/17/2026 3:58:37 PM
+Copyright (c) 2017 Turn Tactics
+
+Permission is hereby granted, free of charge, to any person obtaining a copy
+of this software and associated documentation files (the "Software"), to deal
+in the Software without restriction, including without limitation the rights
+to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+copies of the Software, and to permit persons to whom the Software is
+furnished to do so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in
+all copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+SOFTWARE.
+
+Purpose: Defines a lock-free triple buffer for handing the newest copy of some
+         data from one producer thread to one consumer thread.
+
+Author: James Womack
+
+********************************************************************************/
+#pragma once
+
+#include "../Common.h"
+
+#include <atomic>
+
+namespace lse
+{
+  // Lets one thread publish values that another thread reads without either
+  // one waiting. The writer fills its own buffer and swaps it with the middle
+  // buffer, the reader swaps the middle buffer with its own when it wants the
+  // newest value. Values skipped by the reader are simply overwritten.
+  //
+  // Buffers are reused rather than cleared, so a writer that rebuilds its
+  // buffer every publish should clear it first and keeps its capacity.
+  template<class T>
+  class TripleBuffer
+  {
+  public:
+    TripleBuffer() :
+      m_write(0), m_read(1), m_middle(2)
+    {
+    }
+
+    TripleBuffer(const TripleBuffer&) = delete;
+    TripleBuffer& operator=(const TripleBuffer&) = delete;
+
+    // The buffer being written, only the writer thread may touch it
+    T& write_buffer() { return m_buffers[m_write]; }
+
+    // Hands the write buffer to the reader and takes back a free one
+    void publish()
+    {
+      const UInt8 previous = m_middle.exchange(static_cast<UInt8>(m_write | FreshBit), std::memory_order_acq_rel);
+      m_write = previous & IndexMask;
+    }
+
+    // Returns if a buffer was published since the last fetch
+    bool has_new() const
+    {
+      return (m_middle.load(std::memory_order_acquire) & FreshBit) != 0;
+    }
+
+    // Takes the newest published buffer if there is one, returns if the read
+    // buffer changed
+    bool fetch()
+    {
+      if (!has_new())
+      {
+        return false;
+      }
+
+      const UInt8 previous = m_middle.exchange(m_read, std::memory_order_acq_rel);
+      m_read = previous & IndexMask;
+      return true;
+    }
+
+    // The buffer being read, only the reader thread may touch it
+    const T& read_buffer() const { return m_buffers[m_read]; }
+
+  private:
+    static const UInt8 IndexMask = 0x03;
+    static const UInt8 FreshBit = 0x04;
+
+    T m_buffers[3];
+
+    // Each side's index lives on its own cache line so the threads do not
+    // fight over it
+    alignas(64) UInt8 m_write;
+    alignas(64) UInt8 m_read;
+    alignas(64) std::atomic<UInt8> m_middle;
+  };
+}